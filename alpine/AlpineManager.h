@@ -31,6 +31,7 @@ protected:
     int nt_m;
     Vector_t<int, Dim> nr_m;
     double lbt_m;
+    bool measuredCost_m = false;
     std::string solver_m;
     std::string stepMethod_m;
 public:
@@ -78,6 +79,10 @@ public:
 
     void setLoadBalanceThreshold(double lbt_) { lbt_m = lbt_; }
 
+    bool getMeasuredCost() const { return measuredCost_m; }
+
+    void setMeasuredCost(bool measured) { measuredCost_m = measured; }
+
     const std::string& getStepMethod() const { return stepMethod_m; }
 
     void setStepMethod(const std::string& stepMethod_) { stepMethod_m = stepMethod_; }
@@ -149,7 +154,13 @@ public:
 	}
 
 	double cellVolume = std::reduce(hr.begin(), hr.end(), 1., std::multiplies<double>());
+
+        // The normalisation is purely local work per cell, which the measured
+        // cost model uses for the cell weight; the norm is a reduction and not timed
+        static IpplTimings::TimerRef tnormalize = IpplTimings::getTimer("normalizeRho");
+        IpplTimings::startTimer(tnormalize);
         (*rho)          = (*rho) / cellVolume;
+        IpplTimings::stopTimer(tnormalize);
 
         rhoNorm_m = norm(*rho);
 
@@ -159,7 +170,9 @@ public:
             for (unsigned d = 0; d < Dim; d++) {
                 size *= rmax[d] - rmin[d];
             }
+            IpplTimings::startTimer(tnormalize);
             *rho = *rho - (Q / size);
+            IpplTimings::stopTimer(tnormalize);
         }
    }
 };
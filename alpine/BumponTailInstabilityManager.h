@@ -140,6 +140,7 @@ public:
         this->fsolver_m->initSolver();
 
         this->setLoadBalancer( std::make_shared<LoadBalancer_t>( this->lbt_m, this->fcontainer_m, this->pcontainer_m, this->fsolver_m) );
+        this->loadbalancer_m->setMeasuredCost(this->measuredCost_m);
 
         initializeParticles();
 
@@ -332,6 +333,9 @@ public:
                 IpplTimings::stopTimer(domainDecomposition);
         }
 
+        // Restore the memory locality of the particles before depositing
+        this->sortParticles(it + 1, fc->getMesh(), fc->getFL());
+
         // scatter the charge onto the underlying grid
         this->par2grid();
 
@@ -92,6 +92,7 @@ public:
         this->fsolver_m->initSolver();
 
         this->setLoadBalancer( std::make_shared<LoadBalancer_t>( this->lbt_m, this->fcontainer_m, this->pcontainer_m, this->fsolver_m) );
+        this->loadbalancer_m->setMeasuredCost(this->measuredCost_m);
 
         initializeParticles();
 
@@ -113,7 +114,7 @@ public:
 
         IpplTimings::stopTimer(SolveTimer);
 
-        this->grid2par();
+        // The fused push interpolates the field itself, so pc->E is not filled
 
         this->dump();
 
@@ -222,8 +223,6 @@ public:
         // Here, we assume a constant charge-to-mass ratio of -1 for
         // all the particles hence eliminating the need to store mass as
         // an attribute
-        static IpplTimings::TimerRef PTimer           = IpplTimings::getTimer("pushVelocity");
-        static IpplTimings::TimerRef RTimer           = IpplTimings::getTimer("pushPosition");
         static IpplTimings::TimerRef updateTimer      = IpplTimings::getTimer("update");
         static IpplTimings::TimerRef domainDecomposition = IpplTimings::getTimer("loadBalance");
         static IpplTimings::TimerRef SolveTimer       = IpplTimings::getTimer("solve");
@@ -232,18 +231,13 @@ public:
         std::shared_ptr<ParticleContainer_t> pc = this->pcontainer_m;
         std::shared_ptr<FieldContainer_t> fc    = this->fcontainer_m;
 
-        IpplTimings::startTimer(PTimer);
-        pc->P = pc->P - 0.5 * dt * pc->E;
-        IpplTimings::stopTimer(PTimer);
-
-        // drift
-        IpplTimings::startTimer(RTimer);
-        pc->R = pc->R + dt * pc->P;
-        IpplTimings::stopTimer(RTimer);
+        // kick, drift and particle boundary conditions in a single pass
+        ippl::pushParticles(ippl::LeapFrogPusher<double, Dim>{-0.5 * dt, dt}, fc->getE(), *pc,
+                            pc->P);
 
         // Since the particles have moved spatially update them to correct processors
         IpplTimings::startTimer(updateTimer);
-        pc->update();
+        pc->update(false);
         IpplTimings::stopTimer(updateTimer);
 
         size_type totalP        = this->totalP_m;
@@ -257,6 +251,9 @@ public:
                 IpplTimings::stopTimer(domainDecomposition);
         }
 
+        // Restore the memory locality of the particles before depositing
+        this->sortParticles(it + 1, fc->getMesh(), fc->getFL());
+
         // scatter the charge onto the underlying grid
         this->par2grid();
 
@@ -265,13 +262,9 @@ public:
         this->fsolver_m->runSolver();
         IpplTimings::stopTimer(SolveTimer);
 
-        // gather E field
-        this->grid2par();
-
-        // kick
-        IpplTimings::startTimer(PTimer);
-        pc->P = pc->P - 0.5 * dt * pc->E;
-        IpplTimings::stopTimer(PTimer);
+        // gather E field and kick
+        ippl::pushParticles(ippl::LeapFrogPusher<double, Dim>{-0.5 * dt, 0.0}, fc->getE(), *pc,
+                            pc->P);
     }
 
     void dump() override {
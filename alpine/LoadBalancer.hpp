@@ -17,6 +17,7 @@ class LoadBalancer{
         std::shared_ptr<FieldSolver_t> fs_m;
         unsigned int loadbalancefreq_m;
         ORB<T, Dim> orb;
+        std::unique_ptr<ippl::CostModel> cost_m;
     public:
         LoadBalancer(double lbs, std::shared_ptr<FieldContainer<T,Dim>> &fc, std::shared_ptr<ParticleContainer<T, Dim>> &pc, std::shared_ptr<FieldSolver_t> &fs)
            :loadbalancethreshold_m(lbs), rho_m(&fc->getRho()), E_m(&fc->getE()), phi_m(&fc->getPhi()), pc_m(pc), fs_m(fs) {}
@@ -38,6 +39,24 @@ class LoadBalancer{
         std::shared_ptr<ParticleContainer<T, Dim>> getParticleContainer() const { return pc_m; }
         void setParticleContainer(std::shared_ptr<ParticleContainer<T, Dim>> pc) { pc_m = pc; }
 
+        // Balance the measured time per rank instead of the particle count; the
+        // threshold then bounds the ratio of the maximum to the mean time minus one.
+        // Only timers of local kernels are measured: the halo exchanges, the particle
+        // messages and the solvers wait for other ranks. The cell weight therefore
+        // comes from the charge normalisation alone and underestimates the solver.
+        void setMeasuredCost(bool measured) {
+            if (measured) {
+                cost_m = std::make_unique<ippl::CostModel>(
+                    std::vector<std::string>{"pushParticles", "scatter", "gather",
+                                             "locateParticles", "sendPreprocess"},
+                    std::vector<std::string>{"normalizeRho"});
+            } else {
+                cost_m.reset();
+                orb.setCostWeights(1, 0);
+                orb.setRankCapacities({});
+            }
+        }
+
         std::shared_ptr<FieldSolver_t> getFieldSolver() const { return fs_m; }
         void setFieldSolver(std::shared_ptr<FieldSolver_t> fs) { fs_m = fs; }
 
@@ -50,7 +69,8 @@ class LoadBalancer{
             (*rho_m).updateLayout(*fl);
 
             if (fs_m->getStype() == "CG") {
-                phi_m->updateLayout(*fl);
+                // Keep the previous solution as the initial guess of the solver
+                ippl::redistribute(*fl, *phi_m);
                 phi_m->setFieldBC(phi_m->getFieldBC());
             }
 
@@ -101,6 +121,15 @@ class LoadBalancer{
             if (ippl::Comm->size() < 2) {
                 return false;
             }
+            if (cost_m) {
+                cost_m->measure(pc_m->getLocalNum(), rho_m->getLayout().getLocalNDIndex().size());
+                if (cost_m->particleCost() + cost_m->cellCost() > 0) {
+                    orb.setCostWeights(cost_m->particleCost(), cost_m->cellCost());
+                    // Faster ranks receive proportionally more work
+                    orb.setRankCapacities(cost_m->capacities());
+                }
+                return cost_m->imbalance() > 1 + loadbalancethreshold_m;
+            }
             if (std::strcmp(TestName, "UniformPlasmaTest") == 0) {
                 return (nstep % loadbalancefreq_m == 0);
             } else {
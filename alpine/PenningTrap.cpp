@@ -2,7 +2,7 @@
 //   Usage:
 //     srun ./PenningTrap
 //                  <nx> [<ny>...] <Np> <Nt> <stype> <lbthres>
-//                  <t_method> --overallocate <ovfactor> --info 10
+//                  <t_method> [--measured-cost] --overallocate <ovfactor> --info 10
 //     nx       = No. cell-centered points in the x-direction
 //     ny       = No. cell-centered points in the y-direction
 //     nz       = No. cell-centered points in the z-direction
@@ -14,6 +14,8 @@
 //                particle load balancing occurs. A value of 0.01 is good for many typical
 //                simulations.
 //     t_method = Time-stepping method used e.g. Leapfrog
+//     --measured-cost = Balance the measured kernel time per rank instead of the particle
+//                count; lbthres then bounds the ratio of the maximum to the mean time minus one
 //     ovfactor = Over-allocation factor for the buffers used in the communication. Typical
 //                values are 1.0, 2.0. Value 1.0 means no over-allocation.
 //     Example:
@@ -29,6 +31,7 @@ const char* TestName   = "PenningTrap";
 #include <Kokkos_MathematicalFunctions.hpp>
 #include <Kokkos_Random.hpp>
 #include <chrono>
+#include <cstring>
 #include <iostream>
 #include <random>
 #include <set>
@@ -66,6 +69,11 @@ int main(int argc, char* argv[]) {
 
         // Create an instance of a manger for the considered application
         PenningTrapManager<T, Dim> manager(totalP, nt, nr, lbt, solver, step_method);
+        for (; arg < argc; ++arg) {
+            if (std::strcmp(argv[arg], "--measured-cost") == 0) {
+                manager.setMeasuredCost(true);
+            }
+        }
 
         // Perform pre-run operations, including creating mesh, particles,...
         manager.pre_run();
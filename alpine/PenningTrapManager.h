@@ -36,7 +36,6 @@ private:
     unsigned int nrMax_m;
     double dxFinest_m;
     double alpha_m;
-    double DrInv_m;
 
 public:
 
@@ -65,7 +64,6 @@ public:
         this->time_m = 0.0;
 
         this->alpha_m = -0.5 * this->dt_m;
-        DrInv_m = 1.0 / (1 + (std::pow((this->alpha_m * Bext_m), 2)));
 
         m << "Discretization:" << endl << "nt " << this->nt_m << " Np= " << this->totalP_m << " grid = " << this->nr_m << endl;
 
@@ -82,6 +80,7 @@ public:
         this->fsolver_m->initSolver();
 
         this->setLoadBalancer( std::make_shared<LoadBalancer_t>( this->lbt_m, this->fcontainer_m, this->pcontainer_m, this->fsolver_m) );
+        this->loadbalancer_m->setMeasuredCost(this->measuredCost_m);
 
         initializeParticles();
 
@@ -103,7 +102,7 @@ public:
 
         IpplTimings::stopTimer(SolveTimer);
 
-        this->grid2par();
+        // The fused push interpolates the field itself, so pc->E is not filled
 
         this->dump();
 
@@ -215,15 +214,12 @@ public:
         // Here, we assume a constant charge-to-mass ratio of -1 for
         // all the particles hence eliminating the need to store mass as
         // an attribute
-        static IpplTimings::TimerRef PTimer           = IpplTimings::getTimer("pushVelocity");
-        static IpplTimings::TimerRef RTimer           = IpplTimings::getTimer("pushPosition");
         static IpplTimings::TimerRef updateTimer      = IpplTimings::getTimer("update");
         static IpplTimings::TimerRef domainDecomposition = IpplTimings::getTimer("loadBalance");
         static IpplTimings::TimerRef SolveTimer       = IpplTimings::getTimer("solve");
 
         double alpha = this->alpha_m;
         double Bext = this->Bext_m;
-        double DrInv = this->DrInv_m;
         double V0  = 30 * this->length_m[2];
         Vector_t<double, Dim> length = this->length_m;
         Vector_t<double, Dim> origin = this->origin_m;
@@ -231,39 +227,24 @@ public:
         std::shared_ptr<ParticleContainer_t> pc = this->pcontainer_m;
         std::shared_ptr<FieldContainer_t> fc = this->fcontainer_m;
 
-        IpplTimings::startTimer(PTimer);
-        auto Rview = pc->R.getView();
-        auto Pview = pc->P.getView();
-        auto Eview = pc->E.getView();
-        Kokkos::parallel_for(
-               "Kick1", pc->getLocalNum(), KOKKOS_LAMBDA(const size_t j) {
-                double Eext_x = -(Rview(j)[0] - origin[0] - 0.5 * length[0])
-                                * (V0 / (2 * Kokkos::pow(length[2], 2)));
-                double Eext_y = -(Rview(j)[1] - origin[1] - 0.5 * length[1])
-                                * (V0 / (2 * Kokkos::pow(length[2], 2)));
-                double Eext_z = (Rview(j)[2] - origin[2] - 0.5 * length[2])
-                                * (V0 / (Kokkos::pow(length[2], 2)));
-
-                Eext_x += Eview(j)[0];
-                Eext_y += Eview(j)[1];
-                Eext_z += Eview(j)[2];
-
-                Pview(j)[0] += alpha * (Eext_x + Pview(j)[1] * Bext);
-                Pview(j)[1] += alpha * (Eext_y - Pview(j)[0] * Bext);
-                Pview(j)[2] += alpha * Eext_z;
-        });
-        Kokkos::fence();
-        ippl::Comm->barrier();
-        IpplTimings::stopTimer(PTimer);
-
-        // drift
-        IpplTimings::startTimer(RTimer);
-        pc->R = pc->R + dt * pc->P;
-        IpplTimings::stopTimer(RTimer);
+        // External fields of the trap
+        auto Eext = KOKKOS_LAMBDA(const Vector_t<double, Dim>& R) {
+            return Vector_t<double, Dim>(
+                -(R[0] - origin[0] - 0.5 * length[0]) * (V0 / (2 * Kokkos::pow(length[2], 2))),
+                -(R[1] - origin[1] - 0.5 * length[1]) * (V0 / (2 * Kokkos::pow(length[2], 2))),
+                (R[2] - origin[2] - 0.5 * length[2]) * (V0 / (Kokkos::pow(length[2], 2))));
+        };
+        auto Bfield = KOKKOS_LAMBDA(const Vector_t<double, Dim>&) {
+            return Vector_t<double, Dim>(0.0, 0.0, Bext);
+        };
+
+        // Boris half step, drift and particle boundary conditions in a single pass
+        ippl::pushParticles(ippl::makeBorisPusher(alpha, dt, Eext, Bfield), fc->getE(), *pc,
+                            pc->P);
 
         // Since the particles have moved spatially update them to correct processors
         IpplTimings::startTimer(updateTimer);
-        pc->update();
+        pc->update(false);
         IpplTimings::stopTimer(updateTimer);
 
         size_type totalP = this->totalP_m;
@@ -277,6 +258,9 @@ public:
             IpplTimings::stopTimer(domainDecomposition);
         }
 
+        // Restore the memory locality of the particles before depositing
+        this->sortParticles(it + 1, fc->getMesh(), fc->getFL());
+
         // scatter the charge onto the underlying grid
         this->par2grid();
 
@@ -285,33 +269,9 @@ public:
         this->fsolver_m->runSolver();
         IpplTimings::stopTimer(SolveTimer);
 
-        // gather E field
-        this->grid2par();
-
-        IpplTimings::startTimer(PTimer);
-        auto R2view = pc->R.getView();
-        auto P2view = pc->P.getView();
-        auto E2view = pc->E.getView();
-        Kokkos::parallel_for(
-           "Kick2", pc->getLocalNum(), KOKKOS_LAMBDA(const size_t j) {
-           double Eext_x = -(R2view(j)[0] - origin[0] - 0.5 * length[0])
-                         * (V0 / (2 * Kokkos::pow(length[2], 2)));
-           double Eext_y = -(R2view(j)[1] - origin[1] - 0.5 * length[1])
-                          * (V0 / (2 * Kokkos::pow(length[2], 2)));
-           double Eext_z = (R2view(j)[2] - origin[2] - 0.5 * length[2])
-                           * (V0 / (Kokkos::pow(length[2], 2)));
-
-           Eext_x += E2view(j)[0];
-           Eext_y += E2view(j)[1];
-           Eext_z += E2view(j)[2];
-
-           P2view(j)[0] = DrInv * (P2view(j)[0] + alpha * (Eext_x + P2view(j)[1] * Bext + alpha * Bext * Eext_y));
-           P2view(j)[1] = DrInv * (P2view(j)[1] + alpha * (Eext_y - P2view(j)[0] * Bext - alpha * Bext * Eext_x));
-           P2view(j)[2] += alpha * Eext_z;
-        });
-        Kokkos::fence();
-        ippl::Comm->barrier();
-        IpplTimings::stopTimer(PTimer);
+        // gather E field and complete the Boris step
+        ippl::pushParticles(ippl::makeBorisPusher(alpha, 0.0, Eext, Bfield), fc->getE(), *pc,
+                            pc->P);
     }
 
     void dump() override {
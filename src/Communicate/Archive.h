@@ -12,6 +12,8 @@
 #ifndef IPPL_ARCHIVE_H
 #define IPPL_ARCHIVE_H
 
+#include <type_traits>
+
 #include "Types/IpplTypes.h"
 #include "Types/ViewTypes.h"
 
@@ -34,7 +36,16 @@ namespace ippl {
             Archive(size_type size = 0);
 
             /*!
-             * Serialize.
+             * Wraps existing memory, e.g. a shared memory segment, without
+             * taking ownership. The archive must not be resized.
+             * @param data the memory to serialize to or deserialize from
+             * @param size the size of the memory in bytes
+             */
+            Archive(pointer_type data, size_type size);
+
+            /*!
+             * Serialize. Contiguous views of trivially copyable types are copied
+             * to the buffer in a single bulk copy.
              * @param view to take data from.
              */
             template <typename T, class... ViewArgs>
@@ -43,8 +54,8 @@ namespace ippl {
             /*!
              * Serialize vector attributes
              *
-             *\remark We need a specialized function for vectors since the vector is
-             * not a trivially copyable class. Hence, we cannot use std::memcpy directly.
+             *\remark Strided views are copied component by component. Contiguous
+             * views are copied in bulk, as vectors are trivially copyable.
              *
              * @param view to take data from.
              */
@@ -52,6 +63,14 @@ namespace ippl {
             void serialize(const Kokkos::View<Vector<T, Dim>*, ViewArgs...>& view,
                            size_type nsends);
 
+            /*!
+             * Serialize vector attributes stored as a structure of arrays. The
+             * components are written one after the other, each as a contiguous block.
+             * @param view to take data from.
+             */
+            template <typename T, std::size_t Dim, class... ViewArgs>
+            void serialize(const Kokkos::View<T* [Dim], ViewArgs...>& view, size_type nsends);
+
             /*!
              * Deserialize.
              * @param view to put data to
@@ -62,14 +81,74 @@ namespace ippl {
             /*!
              * Deserialize vector attributes
              *
-             * \remark We need a specialized function for vectors since the vector is
-             * not a trivially copyable class. Hence, we cannot use std::memcpy directly.
+             * \remark Strided views are copied component by component. Contiguous
+             * views are copied in bulk, as vectors are trivially copyable.
              *
              * @param view to put data to
              */
             template <typename T, unsigned Dim, class... ViewArgs>
             void deserialize(Kokkos::View<Vector<T, Dim>*, ViewArgs...>& view, size_type nrecvs);
 
+            /*!
+             * Deserialize vector attributes stored as a structure of arrays
+             * @param view to put data to
+             */
+            template <typename T, std::size_t Dim, class... ViewArgs>
+            void deserialize(Kokkos::View<T* [Dim], ViewArgs...>& view, size_type nrecvs);
+
+            /*!
+             * Serialize selected elements directly from the view, without an
+             * intermediate copy.
+             * @param view to take data from
+             * @param hash indices of the elements to serialize
+             */
+            template <typename T, class... ViewArgs, class Hash>
+            void pack(const Kokkos::View<T*, ViewArgs...>& view, const Hash& hash);
+
+            template <typename T, unsigned Dim, class... ViewArgs, class Hash>
+            void pack(const Kokkos::View<Vector<T, Dim>*, ViewArgs...>& view, const Hash& hash);
+
+            template <typename T, std::size_t Dim, class... ViewArgs, class Hash>
+            void pack(const Kokkos::View<T* [Dim], ViewArgs...>& view, const Hash& hash);
+
+            /*!
+             * Serialize the selected elements of several views in a single kernel.
+             * The buffer has the same layout as after packing the views one by one.
+             * @param hash indices of the elements to serialize
+             * @param views to take data from, all in the memory space of the hash
+             */
+            template <class Hash, class... Views>
+            void packAll(const Hash& hash, const Views&... views);
+
+            /*!
+             * Deserialize directly into the view, starting at the given offset.
+             * The view must be large enough to hold the received elements.
+             * @param view to put data to
+             * @param offset index of the first element to write
+             * @param nrecvs number of elements to deserialize
+             */
+            template <typename T, class... ViewArgs>
+            void unpack(const Kokkos::View<T*, ViewArgs...>& view, size_type offset,
+                        size_type nrecvs);
+
+            template <typename T, unsigned Dim, class... ViewArgs>
+            void unpack(const Kokkos::View<Vector<T, Dim>*, ViewArgs...>& view, size_type offset,
+                        size_type nrecvs);
+
+            template <typename T, std::size_t Dim, class... ViewArgs>
+            void unpack(const Kokkos::View<T* [Dim], ViewArgs...>& view, size_type offset,
+                        size_type nrecvs);
+
+            /*!
+             * Deserialize into several views in a single kernel, starting at the
+             * given offset. The views must be large enough to hold the received elements.
+             * @param offset index of the first element to write
+             * @param nrecvs number of elements to deserialize
+             * @param views to put data to, all in the same memory space
+             */
+            template <class... Views>
+            void unpackAll(size_type offset, size_type nrecvs, const Views&... views);
+
             /*!
              * @returns a pointer to the data of the buffer
              */
@@ -92,6 +171,26 @@ namespace ippl {
             ~Archive() = default;
 
         private:
+            /*!
+             * Copies contiguous data to the buffer in one bulk copy
+             * @tparam MemorySpace the memory space of the source
+             * @param src the data to copy
+             * @param offset the offset in bytes from the write position
+             * @param nbytes the number of bytes to copy
+             */
+            template <class MemorySpace>
+            void copyToBuffer(const void* src, size_type offset, size_type nbytes);
+
+            /*!
+             * Copies from the buffer to contiguous data in one bulk copy
+             * @tparam MemorySpace the memory space of the destination
+             * @param dst the destination
+             * @param offset the offset in bytes from the read position
+             * @param nbytes the number of bytes to copy
+             */
+            template <class MemorySpace>
+            void copyFromBuffer(void* dst, size_type offset, size_type nbytes);
+
             //! write position for serialization
             size_type writepos_m;
             //! read position for deserialization
@@ -2,31 +2,124 @@
 // Class Archive
 //   Class to (de-)serialize in MPI communication.
 //
+//   Contiguous views of trivially copyable types are copied to and from the
+//   buffer in one bulk copy. The element-wise kernels are only used for
+//   strided views and for the indirect access of pack. packAll and unpackAll
+//   copy several views in a single kernel, which saves one launch per view.
+//
 #include <cstring>
+#include <tuple>
 
 #include "Archive.h"
 
 namespace ippl {
     namespace detail {
 
+        /*!
+         * @returns the number of bytes one element of the view occupies in an archive
+         */
+        template <class View>
+        KOKKOS_INLINE_FUNCTION constexpr size_type archiveElementSize() {
+            if constexpr (View::rank == 2) {
+                return View::static_extent(1) * sizeof(typename View::value_type);
+            } else {
+                return sizeof(typename View::value_type);
+            }
+        }
+
+        /*!
+         * Copies element j of a view to slot i of its block in an archive
+         * @param block the start of the block of the view
+         * @param n the number of elements in the block
+         */
+        template <class View>
+        KOKKOS_INLINE_FUNCTION void packElement(char* block, const View& view, size_type n,
+                                                size_type i, size_type j) {
+            constexpr size_t size = sizeof(typename View::value_type);
+            if constexpr (View::rank == 2) {
+                for (size_t d = 0; d < View::static_extent(1); ++d) {
+                    std::memcpy(block + (d * n + i) * size, &view(j, d), size);
+                }
+            } else {
+                std::memcpy(block + i * size, &view(j), size);
+            }
+        }
+
+        /*!
+         * Copies slot i of the block of a view in an archive to element j of the view
+         * @param block the start of the block of the view
+         * @param n the number of elements in the block
+         */
+        template <class View>
+        KOKKOS_INLINE_FUNCTION void unpackElement(const char* block, const View& view,
+                                                  size_type n, size_type i, size_type j) {
+            constexpr size_t size = sizeof(typename View::value_type);
+            if constexpr (View::rank == 2) {
+                for (size_t d = 0; d < View::static_extent(1); ++d) {
+                    std::memcpy(&view(j, d), block + (d * n + i) * size, size);
+                }
+            } else {
+                std::memcpy(&view(j), block + i * size, size);
+            }
+        }
+
         template <class... Properties>
         Archive<Properties...>::Archive(size_type size)
             : writepos_m(0)
             , readpos_m(0)
             , buffer_m("buffer", size) {}
 
+        template <class... Properties>
+        Archive<Properties...>::Archive(pointer_type data, size_type size)
+            : writepos_m(0)
+            , readpos_m(0)
+            , buffer_m(data, size) {}
+
+        template <class... Properties>
+        template <class MemorySpace>
+        void Archive<Properties...>::copyToBuffer(const void* src, size_type offset,
+                                                  size_type nbytes) {
+            using buffer_space = typename buffer_type::memory_space;
+            Kokkos::View<char*, buffer_space, Kokkos::MemoryUnmanaged> dst(
+                buffer_m.data() + writepos_m + offset, nbytes);
+            Kokkos::View<const char*, MemorySpace, Kokkos::MemoryUnmanaged> data(
+                static_cast<const char*>(src), nbytes);
+            Kokkos::deep_copy(dst, data);
+        }
+
+        template <class... Properties>
+        template <class MemorySpace>
+        void Archive<Properties...>::copyFromBuffer(void* dst, size_type offset,
+                                                    size_type nbytes) {
+            using buffer_space = typename buffer_type::memory_space;
+            Kokkos::View<const char*, buffer_space, Kokkos::MemoryUnmanaged> src(
+                buffer_m.data() + readpos_m + offset, nbytes);
+            Kokkos::View<char*, MemorySpace, Kokkos::MemoryUnmanaged> data(
+                static_cast<char*>(dst), nbytes);
+            Kokkos::deep_copy(data, src);
+        }
+
         template <class... Properties>
         template <typename T, class... ViewArgs>
         void Archive<Properties...>::serialize(const Kokkos::View<T*, ViewArgs...>& view,
                                                size_type nsends) {
-            using exec_space  = typename Kokkos::View<T*, ViewArgs...>::execution_space;
+            using view_type   = Kokkos::View<T*, ViewArgs...>;
+            using exec_space  = typename view_type::execution_space;
             using policy_type = Kokkos::RangePolicy<exec_space>;
 
             size_t size = sizeof(T);
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (view.stride(0) == 1) {
+                    copyToBuffer<typename view_type::memory_space>(view.data(), 0,
+                                                                   size * nsends);
+                    writepos_m += size * nsends;
+                    return;
+                }
+            }
             Kokkos::parallel_for(
                 "Archive::serialize()", policy_type(0, nsends),
                 KOKKOS_CLASS_LAMBDA(const size_type i) {
-                    std::memcpy(buffer_m.data() + i * size + writepos_m, view.data() + i, size);
+                    std::memcpy(buffer_m.data() + i * size + writepos_m, &view(i), size);
                 });
             Kokkos::fence();
             writepos_m += size * nsends;
@@ -36,9 +129,19 @@ namespace ippl {
         template <typename T, unsigned Dim, class... ViewArgs>
         void Archive<Properties...>::serialize(
             const Kokkos::View<Vector<T, Dim>*, ViewArgs...>& view, size_type nsends) {
-            using exec_space = typename Kokkos::View<T*, ViewArgs...>::execution_space;
+            using view_type  = Kokkos::View<Vector<T, Dim>*, ViewArgs...>;
+            using exec_space = typename view_type::execution_space;
 
             size_t size = sizeof(T);
+            if constexpr (std::is_trivially_copyable_v<Vector<T, Dim>>
+                          && sizeof(Vector<T, Dim>) == Dim * sizeof(T)) {
+                if (view.stride(0) == 1) {
+                    copyToBuffer<typename view_type::memory_space>(view.data(), 0,
+                                                                   Dim * size * nsends);
+                    writepos_m += Dim * size * nsends;
+                    return;
+                }
+            }
             // Default index type for range policies is int64,
             // so we have to explicitly specify size_type (uint64)
             using mdrange_t =
@@ -51,8 +154,39 @@ namespace ippl {
                 // to avoid compiler warnings
                 mdrange_t({0, 0}, {(long int)nsends, Dim}),
                 KOKKOS_CLASS_LAMBDA(const size_type i, const size_t d) {
-                    std::memcpy(buffer_m.data() + (Dim * i + d) * size + writepos_m,
-                                &(*(view.data() + i))[d], size);
+                    std::memcpy(buffer_m.data() + (Dim * i + d) * size + writepos_m, &view(i)[d],
+                                size);
+                });
+            Kokkos::fence();
+            writepos_m += Dim * size * nsends;
+        }
+
+        template <class... Properties>
+        template <typename T, std::size_t Dim, class... ViewArgs>
+        void Archive<Properties...>::serialize(const Kokkos::View<T* [Dim], ViewArgs...>& view,
+                                               size_type nsends) {
+            using view_type  = Kokkos::View<T* [Dim], ViewArgs...>;
+            using exec_space = typename view_type::execution_space;
+
+            size_t size = sizeof(T);
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (view.stride(0) == 1) {
+                    // One bulk copy per component
+                    for (size_t d = 0; d < Dim; ++d) {
+                        copyToBuffer<typename view_type::memory_space>(
+                            view.data() + d * view.stride(1), d * nsends * size, size * nsends);
+                    }
+                    writepos_m += Dim * size * nsends;
+                    return;
+                }
+            }
+            using mdrange_t =
+                Kokkos::MDRangePolicy<Kokkos::Rank<2>, Kokkos::IndexType<size_type>, exec_space>;
+            Kokkos::parallel_for(
+                "Archive::serialize()", mdrange_t({0, 0}, {(long int)nsends, Dim}),
+                KOKKOS_CLASS_LAMBDA(const size_type i, const size_t d) {
+                    std::memcpy(buffer_m.data() + (d * nsends + i) * size + writepos_m,
+                                &view(i, d), size);
                 });
             Kokkos::fence();
             writepos_m += Dim * size * nsends;
@@ -62,17 +196,150 @@ namespace ippl {
         template <typename T, class... ViewArgs>
         void Archive<Properties...>::deserialize(Kokkos::View<T*, ViewArgs...>& view,
                                                  size_type nrecvs) {
+            if (nrecvs > view.extent(0)) {
+                Kokkos::realloc(view, nrecvs);
+            }
+            unpack(view, 0, nrecvs);
+        }
+
+        template <class... Properties>
+        template <typename T, unsigned Dim, class... ViewArgs>
+        void Archive<Properties...>::deserialize(Kokkos::View<Vector<T, Dim>*, ViewArgs...>& view,
+                                                 size_type nrecvs) {
+            if (nrecvs > view.extent(0)) {
+                Kokkos::realloc(view, nrecvs);
+            }
+            unpack(view, 0, nrecvs);
+        }
+
+        template <class... Properties>
+        template <typename T, std::size_t Dim, class... ViewArgs>
+        void Archive<Properties...>::deserialize(Kokkos::View<T* [Dim], ViewArgs...>& view,
+                                                 size_type nrecvs) {
+            if (nrecvs > view.extent(0)) {
+                Kokkos::realloc(view, nrecvs);
+            }
+            unpack(view, 0, nrecvs);
+        }
+
+        template <class... Properties>
+        template <typename T, class... ViewArgs, class Hash>
+        void Archive<Properties...>::pack(const Kokkos::View<T*, ViewArgs...>& view,
+                                          const Hash& hash) {
             using exec_space  = typename Kokkos::View<T*, ViewArgs...>::execution_space;
             using policy_type = Kokkos::RangePolicy<exec_space>;
 
+            size_t size      = sizeof(T);
+            size_type nsends = hash.extent(0);
+            Kokkos::parallel_for(
+                "Archive::pack()", policy_type(0, nsends), KOKKOS_CLASS_LAMBDA(const size_type i) {
+                    std::memcpy(buffer_m.data() + i * size + writepos_m, &view(hash(i)), size);
+                });
+            Kokkos::fence();
+            writepos_m += size * nsends;
+        }
+
+        template <class... Properties>
+        template <typename T, unsigned Dim, class... ViewArgs, class Hash>
+        void Archive<Properties...>::pack(const Kokkos::View<Vector<T, Dim>*, ViewArgs...>& view,
+                                          const Hash& hash) {
+            using exec_space = typename Kokkos::View<T*, ViewArgs...>::execution_space;
+
+            size_t size      = sizeof(T);
+            size_type nsends = hash.extent(0);
+            using mdrange_t =
+                Kokkos::MDRangePolicy<Kokkos::Rank<2>, Kokkos::IndexType<size_type>, exec_space>;
+            Kokkos::parallel_for(
+                "Archive::pack()", mdrange_t({0, 0}, {(long int)nsends, Dim}),
+                KOKKOS_CLASS_LAMBDA(const size_type i, const size_t d) {
+                    std::memcpy(buffer_m.data() + (Dim * i + d) * size + writepos_m,
+                                &view(hash(i))[d], size);
+                });
+            Kokkos::fence();
+            writepos_m += Dim * size * nsends;
+        }
+
+        template <class... Properties>
+        template <typename T, std::size_t Dim, class... ViewArgs, class Hash>
+        void Archive<Properties...>::pack(const Kokkos::View<T* [Dim], ViewArgs...>& view,
+                                          const Hash& hash) {
+            using exec_space = typename Kokkos::View<T* [Dim], ViewArgs...>::execution_space;
+
+            size_t size      = sizeof(T);
+            size_type nsends = hash.extent(0);
+            using mdrange_t =
+                Kokkos::MDRangePolicy<Kokkos::Rank<2>, Kokkos::IndexType<size_type>, exec_space>;
+            Kokkos::parallel_for(
+                "Archive::pack()", mdrange_t({0, 0}, {(long int)nsends, Dim}),
+                KOKKOS_CLASS_LAMBDA(const size_type i, const size_t d) {
+                    std::memcpy(buffer_m.data() + (d * nsends + i) * size + writepos_m,
+                                &view(hash(i), d), size);
+                });
+            Kokkos::fence();
+            writepos_m += Dim * size * nsends;
+        }
+
+        template <class... Properties>
+        template <class Hash, class... Views>
+        void Archive<Properties...>::packAll(const Hash& hash, const Views&... views) {
+            using exec_space  = typename Hash::execution_space;
+            using policy_type = Kokkos::RangePolicy<exec_space>;
+
+            size_type nsends = hash.extent(0);
+            char* start      = buffer_m.data() + writepos_m;
+            Kokkos::parallel_for(
+                "Archive::packAll()", policy_type(0, nsends), KOKKOS_LAMBDA(const size_type i) {
+                    // The blocks of the views follow each other
+                    char* block = start;
+                    ((packElement(block, views, nsends, i, hash(i)),
+                      block += nsends * archiveElementSize<Views>()),
+                     ...);
+                });
+            Kokkos::fence();
+            writepos_m += nsends * (archiveElementSize<Views>() + ... + 0);
+        }
+
+        template <class... Properties>
+        template <class... Views>
+        void Archive<Properties...>::unpackAll(size_type offset, size_type nrecvs,
+                                               const Views&... views) {
+            using exec_space =
+                typename std::tuple_element_t<0, std::tuple<Views...>>::execution_space;
+            using policy_type = Kokkos::RangePolicy<exec_space>;
+
+            const char* start = buffer_m.data() + readpos_m;
+            Kokkos::parallel_for(
+                "Archive::unpackAll()", policy_type(0, nrecvs), KOKKOS_LAMBDA(const size_type i) {
+                    const char* block = start;
+                    ((unpackElement(block, views, nrecvs, i, offset + i),
+                      block += nrecvs * archiveElementSize<Views>()),
+                     ...);
+                });
+            Kokkos::fence();
+            readpos_m += nrecvs * (archiveElementSize<Views>() + ... + 0);
+        }
+
+        template <class... Properties>
+        template <typename T, class... ViewArgs>
+        void Archive<Properties...>::unpack(const Kokkos::View<T*, ViewArgs...>& view,
+                                            size_type offset, size_type nrecvs) {
+            using view_type   = Kokkos::View<T*, ViewArgs...>;
+            using exec_space  = typename view_type::execution_space;
+            using policy_type = Kokkos::RangePolicy<exec_space>;
+
             size_t size = sizeof(T);
-            if (nrecvs > view.extent(0)) {
-                Kokkos::realloc(view, nrecvs);
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (view.stride(0) == 1) {
+                    copyFromBuffer<typename view_type::memory_space>(view.data() + offset, 0,
+                                                                     size * nrecvs);
+                    readpos_m += size * nrecvs;
+                    return;
+                }
             }
             Kokkos::parallel_for(
-                "Archive::deserialize()", policy_type(0, nrecvs),
+                "Archive::unpack()", policy_type(0, nrecvs),
                 KOKKOS_CLASS_LAMBDA(const size_type i) {
-                    std::memcpy(view.data() + i, buffer_m.data() + i * size + readpos_m, size);
+                    std::memcpy(&view(offset + i), buffer_m.data() + i * size + readpos_m, size);
                 });
             // Wait for deserialization kernel to complete
             // (as with serialization kernels)
@@ -82,24 +349,62 @@ namespace ippl {
 
         template <class... Properties>
         template <typename T, unsigned Dim, class... ViewArgs>
-        void Archive<Properties...>::deserialize(Kokkos::View<Vector<T, Dim>*, ViewArgs...>& view,
-                                                 size_type nrecvs) {
-            using exec_space = typename Kokkos::View<T*, ViewArgs...>::execution_space;
+        void Archive<Properties...>::unpack(const Kokkos::View<Vector<T, Dim>*, ViewArgs...>& view,
+                                            size_type offset, size_type nrecvs) {
+            using view_type  = Kokkos::View<Vector<T, Dim>*, ViewArgs...>;
+            using exec_space = typename view_type::execution_space;
 
             size_t size = sizeof(T);
-            if (nrecvs > view.extent(0)) {
-                Kokkos::realloc(view, nrecvs);
+            if constexpr (std::is_trivially_copyable_v<Vector<T, Dim>>
+                          && sizeof(Vector<T, Dim>) == Dim * sizeof(T)) {
+                if (view.stride(0) == 1) {
+                    copyFromBuffer<typename view_type::memory_space>(view.data() + offset, 0,
+                                                                     Dim * size * nrecvs);
+                    readpos_m += Dim * size * nrecvs;
+                    return;
+                }
             }
             using mdrange_t =
                 Kokkos::MDRangePolicy<Kokkos::Rank<2>, Kokkos::IndexType<size_type>, exec_space>;
             Kokkos::parallel_for(
-                "Archive::deserialize()", mdrange_t({0, 0}, {(long int)nrecvs, Dim}),
+                "Archive::unpack()", mdrange_t({0, 0}, {(long int)nrecvs, Dim}),
                 KOKKOS_CLASS_LAMBDA(const size_type i, const size_t d) {
-                    std::memcpy(&(*(view.data() + i))[d],
+                    std::memcpy(&view(offset + i)[d],
                                 buffer_m.data() + (Dim * i + d) * size + readpos_m, size);
                 });
             Kokkos::fence();
             readpos_m += Dim * size * nrecvs;
         }
+
+        template <class... Properties>
+        template <typename T, std::size_t Dim, class... ViewArgs>
+        void Archive<Properties...>::unpack(const Kokkos::View<T* [Dim], ViewArgs...>& view,
+                                            size_type offset, size_type nrecvs) {
+            using view_type  = Kokkos::View<T* [Dim], ViewArgs...>;
+            using exec_space = typename view_type::execution_space;
+
+            size_t size = sizeof(T);
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (view.stride(0) == 1) {
+                    for (size_t d = 0; d < Dim; ++d) {
+                        copyFromBuffer<typename view_type::memory_space>(
+                            view.data() + offset + d * view.stride(1), d * nrecvs * size,
+                            size * nrecvs);
+                    }
+                    readpos_m += Dim * size * nrecvs;
+                    return;
+                }
+            }
+            using mdrange_t =
+                Kokkos::MDRangePolicy<Kokkos::Rank<2>, Kokkos::IndexType<size_type>, exec_space>;
+            Kokkos::parallel_for(
+                "Archive::unpack()", mdrange_t({0, 0}, {(long int)nrecvs, Dim}),
+                KOKKOS_CLASS_LAMBDA(const size_type i, const size_t d) {
+                    std::memcpy(&view(offset + i, d),
+                                buffer_m.data() + (d * nrecvs + i) * size + readpos_m, size);
+                });
+            Kokkos::fence();
+            readpos_m += Dim * size * nrecvs;
+        }
     }  // namespace detail
 }  // namespace ippl
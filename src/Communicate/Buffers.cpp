@@ -35,6 +35,7 @@ namespace ippl {
             buffers_m.forAll([]<typename Map>(Map&& m) {
                 m.clear();
             });
+            mailbox_m.reset();
         }
     }  // namespace mpi
 }  // namespace ippl
@@ -1,3 +1,7 @@
+#include <cstring>
+#include <type_traits>
+#include <typeinfo>
+
 #include "Communicate/DataTypes.h"
 
 #include "Communicate/Operations.h"
@@ -11,6 +15,13 @@ namespace ippl {
             MPI_Gather(const_cast<T*>(input), count, type, output, count, type, root, *comm_m);
         }
 
+        template <typename T>
+        void Communicator::allgather(const T* input, T* output, int count) {
+            MPI_Datatype type = get_mpi_datatype<T>(*input);
+
+            MPI_Allgather(const_cast<T*>(input), count, type, output, count, type, *comm_m);
+        }
+
         template <typename T>
         void Communicator::scatter(const T* input, T* output, int count, int root) {
             MPI_Datatype type = get_mpi_datatype<T>(*input);
@@ -59,5 +70,53 @@ namespace ippl {
         void Communicator::allreduce(T& inout, int count, Op op) {
             allreduce(&inout, count, op);
         }
+
+        template <typename T, class Op>
+        void Communicator::allreduceCustom(T& inout, Op) {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "Custom reductions require trivially copyable values");
+            static_assert(std::is_empty_v<Op>, "Custom reduction operations must be stateless");
+
+            // The values are sent as raw bytes. The datatype and the operation are
+            // created once for each combination of value type and operation and are
+            // freed by ippl::finalize.
+            auto [custom, created] =
+                customOps_m.try_emplace(std::type_index(typeid(std::pair<T, Op>)));
+            auto& [type, mpiOp] = custom->second;
+            if (created) {
+                MPI_Type_contiguous(sizeof(T), MPI_BYTE, &type);
+                MPI_Type_commit(&type);
+                MPI_Op_create(
+                    [](void* inputBuffer, void* outputBuffer, int* len, MPI_Datatype*) {
+                        // The buffers need not be aligned for T
+                        char* input  = static_cast<char*>(inputBuffer);
+                        char* output = static_cast<char*>(outputBuffer);
+                        for (int i = 0; i < *len; ++i) {
+                            T a, b;
+                            std::memcpy(&a, output + i * sizeof(T), sizeof(T));
+                            std::memcpy(&b, input + i * sizeof(T), sizeof(T));
+                            Op{}(a, b);
+                            std::memcpy(output + i * sizeof(T), &a, sizeof(T));
+                        }
+                    },
+                    1, &mpiOp);
+            }
+
+            MPI_Allreduce(MPI_IN_PLACE, &inout, 1, type, mpiOp, *comm_m);
+        }
+
+        template <typename T, class Op>
+        void Communicator::exscan(const T& input, T& output, Op) {
+            MPI_Datatype type = get_mpi_datatype<T>(input);
+
+            MPI_Op mpiOp = get_mpi_op<Op, T>();
+
+            // MPI leaves the receive buffer of rank 0 undefined
+            T result = output;
+            MPI_Exscan(const_cast<T*>(&input), &result, 1, type, mpiOp, *comm_m);
+            if (rank() > 0) {
+                output = result;
+            }
+        }
     }  // namespace mpi
 }  // namespace ippl
@@ -29,6 +29,59 @@ namespace ippl {
             return Communicator(newcomm);
         }
 
+        Communicator Communicator::splitShared() const {
+            MPI_Comm newcomm;
+            MPI_Comm_split_type(*comm_m, MPI_COMM_TYPE_SHARED, rank_m, MPI_INFO_NULL, &newcomm);
+            return Communicator(newcomm);
+        }
+
+        std::vector<int> Communicator::nodeIds() const {
+            MPI_Comm shared;
+            MPI_Comm_split_type(*comm_m, MPI_COMM_TYPE_SHARED, rank_m, MPI_INFO_NULL, &shared);
+
+            // The lowest rank of a node identifies it
+            int leader = rank_m;
+            MPI_Bcast(&leader, 1, MPI_INT, 0, shared);
+            MPI_Comm_free(&shared);
+
+            std::vector<int> leaders(size_m);
+            MPI_Allgather(&leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, *comm_m);
+
+            std::vector<int> ids(size_m);
+            std::vector<int> nodeOfLeader(size_m, -1);
+            int nNodes = 0;
+            for (int rank = 0; rank < size_m; ++rank) {
+                int& node = nodeOfLeader[leaders[rank]];
+                if (node < 0) {
+                    node = nNodes++;
+                }
+                ids[rank] = node;
+            }
+            return ids;
+        }
+
+        bool Communicator::enableSharedMemory = true;
+
+        std::map<std::type_index, std::pair<MPI_Datatype, MPI_Op>> Communicator::customOps_m;
+
+        void Communicator::freeCustomOperations() {
+            for (auto& [key, custom] : customOps_m) {
+                MPI_Type_free(&custom.first);
+                MPI_Op_free(&custom.second);
+            }
+            customOps_m.clear();
+        }
+
+        SharedMailbox* Communicator::getSharedMailbox() {
+            if (!enableSharedMemory) {
+                return nullptr;
+            }
+            if (!mailbox_m) {
+                mailbox_m = std::make_shared<SharedMailbox>(*comm_m);
+            }
+            return mailbox_m->nodeSize() > 1 ? mailbox_m.get() : nullptr;
+        }
+
         void Communicator::probe(int source, int tag, Status& status) {
             MPI_Probe(source, tag, *comm_m, status);
         }
@@ -5,10 +5,15 @@
 #ifndef IPPL_MPI_COMMUNICATOR_H
 #define IPPL_MPI_COMMUNICATOR_H
 
+#include <map>
 #include <memory>
 #include <mpi.h>
+#include <typeindex>
+#include <utility>
+#include <vector>
 
 #include "Communicate/Request.h"
+#include "Communicate/SharedMailbox.h"
 #include "Communicate/Status.h"
 
 ////////////////////////////////////////////////
@@ -38,6 +43,19 @@ namespace ippl {
 
             Communicator split(int color, int key) const;
 
+            /*!
+             * Splits the communicator into groups of ranks that can share memory,
+             * i.e. the ranks on the same node
+             */
+            Communicator splitShared() const;
+
+            /*!
+             * Finds the node of every rank. The nodes are numbered in the order of
+             * their lowest rank. This is a collective call.
+             * @return The node index of each rank
+             */
+            std::vector<int> nodeIds() const;
+
             operator const MPI_Comm&() const noexcept { return *comm_m; }
 
             int size() const noexcept { return size_m; }
@@ -96,6 +114,12 @@ namespace ippl {
             template <typename T>
             void gather(const T* input, T* output, int count, int root = 0);
 
+            /* Gather the data in the given source container from all nodes to
+             * all nodes, ordered by rank.
+             */
+            template <typename T>
+            void allgather(const T* input, T* output, int count);
+
             /* Scatter the data from all other nodes to a
              * specific node (default: 0).
              */
@@ -124,6 +148,25 @@ namespace ippl {
             template <typename T, class Op>
             void allreduce(T& inout, int count, Op op);
 
+            /* Combine a value of all nodes with a custom operation in a single
+             * collective. The operation is called as op(inout, in), must be
+             * associative and commutative, and must not have state.
+             */
+            template <typename T, class Op>
+            void allreduceCustom(T& inout, Op op);
+
+            /* Free the datatypes and operations created by allreduceCustom. This is
+             * called by ippl::finalize before MPI is finalized.
+             */
+            static void freeCustomOperations();
+
+            /* Exclusive prefix reduction over the ranks: rank i receives
+             * the reduction of the inputs of ranks 0 to i-1. The output of
+             * rank 0 is left unchanged.
+             */
+            template <typename T, class Op>
+            void exscan(const T& input, T& output, Op op);
+
             /////////////////////////////////////////////////////////////////////////////////////
             template <typename MemorySpace = Kokkos::DefaultExecutionSpace::memory_space>
             using archive_type = detail::Archive<MemorySpace>;
@@ -155,6 +198,17 @@ namespace ippl {
 
             const MPI_Comm& getCommunicator() const noexcept { return *comm_m; }
 
+            //! Whether messages between ranks on the same node use shared memory
+            static bool enableSharedMemory;
+
+            /*!
+             * Returns the mailbox for messages between ranks on the same node. It is
+             * created by the first call, which is collective over the node.
+             * @return The mailbox, or nullptr if shared memory is disabled or this
+             * rank is alone on its node
+             */
+            SharedMailbox* getSharedMailbox();
+
             template <class Buffer, typename Archive>
             void recv(int src, int tag, Buffer& buffer, Archive& ar, size_type msize,
                       size_type nrecvs) {
@@ -182,6 +236,31 @@ namespace ippl {
                 MPI_Isend(ar.getBuffer(), ar.getSize(), MPI_BYTE, dest, tag, *comm_m, &request);
             }
 
+            /*!
+             * Sends the contents of an archive that has already been filled
+             */
+            template <typename Archive>
+            void isend(int dest, int tag, Archive& ar, MPI_Request& request) {
+                if (ar.getSize() > INT_MAX) {
+                    std::cerr << "Message size exceeds range of int" << std::endl;
+                    this->abort();
+                }
+                MPI_Isend(ar.getBuffer(), ar.getSize(), MPI_BYTE, dest, tag, *comm_m, &request);
+            }
+
+            /*!
+             * Receives a message into an archive without deserializing it
+             */
+            template <typename Archive>
+            void recv(int src, int tag, Archive& ar, size_type msize) {
+                if (msize > INT_MAX) {
+                    std::cerr << "Message size exceeds range of int" << std::endl;
+                    this->abort();
+                }
+                MPI_Status status;
+                MPI_Recv(ar.getBuffer(), msize, MPI_BYTE, src, tag, *comm_m, &status);
+            }
+
             template <typename Archive>
             void irecv(int src, int tag, Archive& ar, MPI_Request& request, size_type msize) {
                 if (msize > INT_MAX) {
@@ -195,6 +274,12 @@ namespace ippl {
             buffer_map_type buffers_m;
             double defaultOveralloc_m = 1.0;
 
+            std::shared_ptr<SharedMailbox> mailbox_m;
+
+            //! The datatype and the operation of allreduceCustom for each value type
+            //! and operation; they do not depend on the communicator
+            static std::map<std::type_index, std::pair<MPI_Datatype, MPI_Op>> customOps_m;
+
             /////////////////////////////////////////////////////////////////////////////////////
 
         protected:
@@ -0,0 +1,133 @@
+//
+// Class SharedMailbox
+//   Exchanges messages between the ranks of a node through shared memory.
+//
+#include "Communicate/SharedMailbox.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "Utility/IpplException.h"
+
+namespace ippl {
+    namespace mpi {
+
+        SharedMailbox::SharedMailbox(MPI_Comm comm) {
+            MPI_Comm_rank(comm, &rank_m);
+            MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank_m, MPI_INFO_NULL, &nodeComm_m);
+            MPI_Comm_size(nodeComm_m, &nodeSize_m);
+
+            // Translate the ranks on the node to ranks of the communicator
+            MPI_Group group, nodeGroup;
+            MPI_Comm_group(comm, &group);
+            MPI_Comm_group(nodeComm_m, &nodeGroup);
+            std::vector<int> nodeRanks(nodeSize_m), ranks(nodeSize_m);
+            std::iota(nodeRanks.begin(), nodeRanks.end(), 0);
+            MPI_Group_translate_ranks(nodeGroup, nodeSize_m, nodeRanks.data(), group,
+                                      ranks.data());
+            MPI_Group_free(&group);
+            MPI_Group_free(&nodeGroup);
+
+            for (int i = 0; i < nodeSize_m; ++i) {
+                nodeRanks_m[ranks[i]] = i;
+            }
+            segments_m.resize(nodeSize_m, nullptr);
+        }
+
+        SharedMailbox::~SharedMailbox() {
+            // The window cannot be freed anymore after MPI has been finalized
+            int finalized = 0;
+            MPI_Finalized(&finalized);
+            if (finalized) {
+                return;
+            }
+            if (win_m != MPI_WIN_NULL) {
+                MPI_Win_unlock_all(win_m);
+                MPI_Win_free(&win_m);
+            }
+            MPI_Comm_free(&nodeComm_m);
+        }
+
+        void SharedMailbox::allocate(size_type nBytes) {
+            if (win_m != MPI_WIN_NULL) {
+                MPI_Win_unlock_all(win_m);
+                MPI_Win_free(&win_m);
+            }
+
+            char* base;
+            MPI_Win_allocate_shared(nBytes, 1, MPI_INFO_NULL, nodeComm_m, &base, &win_m);
+            // A passive target epoch for the whole lifetime of the window allows
+            // the memory to be synchronized with MPI_Win_sync
+            MPI_Win_lock_all(MPI_MODE_NOCHECK, win_m);
+
+            for (int i = 0; i < nodeSize_m; ++i) {
+                MPI_Aint size;
+                int dispUnit;
+                MPI_Win_shared_query(win_m, i, &size, &dispUnit, &segments_m[i]);
+            }
+            capacity_m = nBytes;
+        }
+
+        void SharedMailbox::begin(size_type nMessages, size_type nBytes) {
+            const size_type dataStart   = paddedSize(sizeof(Header) + nMessages * sizeof(Entry));
+            unsigned long long required = dataStart + nBytes + nMessages * alignment;
+
+            // Also waits for the other ranks to finish reading the previous round
+            unsigned long long maxRequired;
+            MPI_Allreduce(&required, &maxRequired, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX,
+                          nodeComm_m);
+            if (maxRequired > capacity_m) {
+                allocate(std::max<size_type>(maxRequired, 2 * capacity_m));
+            }
+
+            maxEntries_m = nMessages;
+            nEntries_m   = 0;
+            writePos_m   = dataStart;
+            found_m.clear();
+        }
+
+        char* SharedMailbox::post(int dest, int tag, size_type nBytes) {
+            char* segment = segments_m[nodeRanks_m.at(rank_m)];
+            if (nEntries_m == maxEntries_m || writePos_m + nBytes > capacity_m) {
+                throw IpplException("SharedMailbox::post",
+                                    "More messages than announced at the begin of the round");
+            }
+
+            Entry* entries        = reinterpret_cast<Entry*>(segment + sizeof(Header));
+            entries[nEntries_m++] = {dest, tag, writePos_m, nBytes};
+
+            char* message = segment + writePos_m;
+            writePos_m += paddedSize(nBytes);
+            return message;
+        }
+
+        void SharedMailbox::publish() {
+            char* segment                                = segments_m[nodeRanks_m.at(rank_m)];
+            reinterpret_cast<Header*>(segment)->nEntries = nEntries_m;
+
+            // Make the messages visible to the node and those of the others to us
+            MPI_Win_sync(win_m);
+            MPI_Barrier(nodeComm_m);
+            MPI_Win_sync(win_m);
+        }
+
+        char* SharedMailbox::find(int src, int tag, size_type nBytes) {
+            char* segment        = segments_m[nodeRanks_m.at(src)];
+            const Header* header = reinterpret_cast<const Header*>(segment);
+            const Entry* entries = reinterpret_cast<const Entry*>(segment + sizeof(Header));
+
+            size_type skip = found_m[{src, tag}]++;
+            for (size_type i = 0; i < header->nEntries; ++i) {
+                const Entry& entry = entries[i];
+                if (entry.dest != rank_m || entry.tag != tag || skip-- > 0) {
+                    continue;
+                }
+                if (entry.size != nBytes) {
+                    throw IpplException("SharedMailbox::find", "Unexpected message size");
+                }
+                return segment + entry.offset;
+            }
+            throw IpplException("SharedMailbox::find", "No such message");
+        }
+    }  // namespace mpi
+}  // namespace ippl
@@ -0,0 +1,147 @@
+//
+// Class SharedMailbox
+//   Exchanges messages between the ranks of a node through shared memory.
+//
+//   Every rank of a node owns a segment of an MPI-3 shared memory window
+//   (MPI_Win_allocate_shared). A rank writes its messages for the other ranks
+//   of the node into its own segment, together with a directory of the
+//   messages, and the receivers read them directly from the sender's segment.
+//   This replaces the copy through the MPI library with a node-local
+//   synchronization. An exchange round consists of
+//
+//     mailbox.begin(nMessages, nBytes);   // collective over the node
+//     char* out = mailbox.post(dest, tag, size);
+//     ... write the message to out ...
+//     mailbox.publish();                  // collective over the node
+//     const char* in = mailbox.find(src, tag, size);
+//     ... read the message from in ...
+//
+//   The messages of a round can be read until the next round begins. Like
+//   MPI, messages with the same source, destination and tag are matched in
+//   the order in which they were posted. The segments are in host memory.
+//
+#ifndef IPPL_SHARED_MAILBOX_H
+#define IPPL_SHARED_MAILBOX_H
+
+#include <map>
+#include <mpi.h>
+#include <utility>
+#include <vector>
+
+#include "Types/IpplTypes.h"
+
+namespace ippl {
+    namespace mpi {
+
+        class SharedMailbox {
+        public:
+            using size_type = detail::size_type;
+
+            //! The alignment of the messages in the segment
+            constexpr static size_type alignment = 64;
+
+            /*!
+             * Creates the communicator of the ranks on the same node. This is a
+             * collective call.
+             * @param comm the communicator whose ranks exchange messages
+             */
+            SharedMailbox(MPI_Comm comm);
+
+            ~SharedMailbox();
+
+            SharedMailbox(const SharedMailbox&)            = delete;
+            SharedMailbox& operator=(const SharedMailbox&) = delete;
+
+            //! @returns the number of ranks on this node
+            int nodeSize() const { return nodeSize_m; }
+
+            /*!
+             * @param rank a rank of the communicator
+             * @returns whether messages to the rank go through the mailbox
+             */
+            bool isLocal(int rank) const {
+                return rank != rank_m && nodeRanks_m.find(rank) != nodeRanks_m.end();
+            }
+
+            /*!
+             * Starts a round. Waits until the messages of the previous round have
+             * been read and makes room for the messages of this round. This is a
+             * collective call of the ranks on the node.
+             * @param nMessages the number of messages this rank posts
+             * @param nBytes the total size of the messages in bytes
+             */
+            void begin(size_type nMessages, size_type nBytes);
+
+            /*!
+             * Reserves a message
+             * @param dest the destination rank
+             * @param tag the message tag
+             * @param nBytes the size of the message in bytes
+             * @returns where the message has to be written
+             */
+            char* post(int dest, int tag, size_type nBytes);
+
+            /*!
+             * Makes the posted messages visible to the other ranks of the node. This
+             * is a collective call of the ranks on the node.
+             */
+            void publish();
+
+            /*!
+             * Finds the next message from a rank of the node
+             * @param src the source rank
+             * @param tag the message tag
+             * @param nBytes the expected size of the message in bytes
+             * @returns where the message can be read
+             */
+            char* find(int src, int tag, size_type nBytes);
+
+            /*!
+             * @returns the space a message of the given size occupies in a segment
+             */
+            static size_type paddedSize(size_type nBytes) {
+                return (nBytes + alignment - 1) / alignment * alignment;
+            }
+
+        private:
+            struct Header {
+                size_type nEntries;
+            };
+
+            struct Entry {
+                int dest;
+                int tag;
+                size_type offset;
+                size_type size;
+            };
+
+            /*!
+             * Replaces the window with one of the given segment size per rank. This
+             * is a collective call of the ranks on the node.
+             */
+            void allocate(size_type nBytes);
+
+            MPI_Comm nodeComm_m;
+            MPI_Win win_m = MPI_WIN_NULL;
+
+            int rank_m;
+            int nodeSize_m;
+
+            //! The rank on the node of each rank of the communicator on this node
+            std::map<int, int> nodeRanks_m;
+
+            //! The segment of each rank on the node
+            std::vector<char*> segments_m;
+            size_type capacity_m = 0;
+
+            size_type maxEntries_m = 0;
+            size_type nEntries_m   = 0;
+            size_type writePos_m   = 0;
+
+            //! The number of messages found per source and tag in this round
+            std::map<std::pair<int, int>, size_type> found_m;
+        };
+    }  // namespace mpi
+}  // namespace ippl
+
+#endif
@@ -38,7 +38,12 @@ namespace ippl {
                 VICO_RECV   = 31000,
 
                 OPEN_SOLVER = 32000,
-                VICO_SOLVER = 32001
+                VICO_SOLVER = 32001,
+
+                // Field redistribution
+                FIELD_REDISTRIBUTE = 32002,
+                REDISTRIBUTE_SEND  = 33000,
+                REDISTRIBUTE_RECV  = 38000
             };
         }  // namespace tag
     }      // namespace mpi
@@ -0,0 +1,158 @@
+//
+// Class CostModel
+//   Estimates the cost of particles and cells from measured kernel times.
+//
+//   Balancing the number of particles only evens out the particle work. The
+//   cost model reads the time spent in particle kernels and in field kernels
+//   from IpplTimings since the last measurement, together with the local
+//   particle and cell counts. From these it derives the cost of one particle
+//   and of one cell, which the ORB uses as weights, and the measured
+//   imbalance, i.e. the ratio of the maximum to the mean time per rank.
+//
+//   The timers must only cover local computation. A timer around blocking
+//   communication (halo exchanges, particle messages, FFT transposes) also
+//   counts the time a fast rank waits for the slow ones, which evens out the
+//   measured times and hides the imbalance. Kernels are only timed correctly
+//   with timer fences enabled.
+//   Ranks of different speed, e.g. on mixed node types, are described by their
+//   capacities, the work a rank completes per unit time relative to the
+//   others, which the ORB uses to give faster ranks larger domains:
+//
+//     ippl::CostModel cost({"pushParticles", "scatter", "gather", "locateParticles"},
+//                          {"myFieldKernel"});
+//     ...
+//     cost.measure(P->getLocalNum(), fl.getLocalNDIndex().size());
+//     if (cost.imbalance() > 1.2) {
+//         orb.setCostWeights(cost.particleCost(), cost.cellCost());
+//         orb.setRankCapacities(cost.capacities());
+//         orb.binaryRepartition(P->R, fl, false);
+//     }
+//
+#ifndef IPPL_COST_MODEL_H
+#define IPPL_COST_MODEL_H
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Types/IpplTypes.h"
+
+#include "Utility/IpplTimings.h"
+
+#include "Communicate/Communicator.h"
+
+namespace ippl {
+
+    class CostModel {
+    public:
+        using size_type = detail::size_type;
+
+        /*!
+         * @param particleTimers the timers whose time scales with the number of particles
+         * @param fieldTimers the timers whose time scales with the number of cells
+         */
+        CostModel(const std::vector<std::string>& particleTimers,
+                  const std::vector<std::string>& fieldTimers)
+            : particleTimers_m(makeTimers(particleTimers))
+            , fieldTimers_m(makeTimers(fieldTimers)) {}
+
+        /*!
+         * Reads the time spent in the timers since the last measurement and
+         * updates the costs and the imbalance. This is a collective call.
+         * @param localParticles the number of local particles
+         * @param localCells the number of local cells
+         */
+        void measure(size_type localParticles, size_type localCells) {
+            // The capacities need the measurements of every rank, so they are
+            // gathered in one collective and all reductions are done locally
+            const int nRanks   = Comm->size();
+            const Sample local = {elapsed(particleTimers_m), elapsed(fieldTimers_m),
+                                  double(localParticles), double(localCells)};
+            std::vector<Sample> samples(nRanks);
+            Comm->allgather(&local.particleTime, &samples.data()->particleTime, 4);
+
+            Sample sum     = {0, 0, 0, 0};
+            double maxTime = 0;
+            for (const Sample& sample : samples) {
+                sum.particleTime += sample.particleTime;
+                sum.fieldTime += sample.fieldTime;
+                sum.particles += sample.particles;
+                sum.cells += sample.cells;
+                maxTime = std::max(maxTime, sample.particleTime + sample.fieldTime);
+            }
+
+            particleCost_m = sum.particles > 0 ? sum.particleTime / sum.particles : 0;
+            cellCost_m     = sum.cells > 0 ? sum.fieldTime / sum.cells : 0;
+
+            const double meanTime = (sum.particleTime + sum.fieldTime) / nRanks;
+            imbalance_m           = meanTime > 0 ? maxTime / meanTime : 1;
+
+            // The work of a rank in units of the mean costs over its time
+            capacities_m.resize(nRanks);
+            for (int rank = 0; rank < nRanks; ++rank) {
+                const Sample& s    = samples[rank];
+                const double time  = s.particleTime + s.fieldTime;
+                const double work  = particleCost_m * s.particles + cellCost_m * s.cells;
+                capacities_m[rank] = (time > 0 && work > 0) ? work / time : 1;
+            }
+        }
+
+        //! @returns the measured time per particle
+        double particleCost() const { return particleCost_m; }
+
+        //! @returns the measured time per cell
+        double cellCost() const { return cellCost_m; }
+
+        //! @returns the ratio of the maximum to the mean time per rank
+        double imbalance() const { return imbalance_m; }
+
+        //! @returns the measured capacity of every rank, i.e. its work per unit time
+        const std::vector<double>& capacities() const { return capacities_m; }
+
+    private:
+        //! The measurement of one rank, sent as four doubles
+        struct Sample {
+            double particleTime;
+            double fieldTime;
+            double particles;
+            double cells;
+        };
+        static_assert(sizeof(Sample) == 4 * sizeof(double), "Samples are sent as doubles");
+
+        struct TimerState {
+            IpplTimings::TimerInfo* info;
+            double last;
+        };
+
+        static std::vector<TimerState> makeTimers(const std::vector<std::string>& names) {
+            std::vector<TimerState> timers;
+            for (const auto& name : names) {
+                // Creates the timer if it does not exist yet
+                IpplTimings::getTimer(name.c_str());
+                IpplTimings::TimerInfo* info = IpplTimings::infoTimer(name.c_str());
+                timers.push_back({info, info->wallTime});
+            }
+            return timers;
+        }
+
+        static double elapsed(std::vector<TimerState>& timers) {
+            double time = 0;
+            for (auto& timer : timers) {
+                time += timer.info->wallTime - timer.last;
+                timer.last = timer.info->wallTime;
+            }
+            return time;
+        }
+
+        std::vector<TimerState> particleTimers_m;
+        std::vector<TimerState> fieldTimers_m;
+
+        double particleCost_m = 0;
+        double cellCost_m     = 0;
+        double imbalance_m    = 1;
+
+        std::vector<double> capacities_m;
+    };
+}  // namespace ippl
+
+#endif
@@ -3,6 +3,8 @@
 //
 // Simple domain decomposition using an Orthogonal Recursive Bisection,
 // domain is divided recursively so as to even weights on each side of the cut,
+// or to divide them in proportion to the capacities of the ranks on each side,
+// cutting all domains of a bisection level together,
 // works with 2^n processors only.
 //
 //
@@ -10,6 +12,7 @@
 #ifndef IPPL_ORTHOGONAL_RECURSIVE_BISECTION_H
 #define IPPL_ORTHOGONAL_RECURSIVE_BISECTION_H
 
+#include "Decomposition/ScatterWeights.h"
 #include "FieldLayout/FieldLayout.h"
 #include "Index/Index.h"
 #include "Index/NDIndex.h"
@@ -30,6 +33,19 @@ namespace ippl {
         using mesh_type               = typename Field::Mesh_t;
         using Tf                      = typename Field::value_type;
 
+        using exec_space       = typename Field::execution_space;
+        using index_type       = typename RangePolicy<Dim, exec_space>::index_type;
+        using index_array_type = typename RangePolicy<Dim, exec_space>::index_array_type;
+
+        /*!
+         * The local cells of one plane perpendicular to a cut axis, given as a
+         * box in view indices, and the entry of the profile it is reduced into
+         */
+        struct PlaneRange {
+            Kokkos::Array<index_type, Dim> begin, end;
+            size_t entry;
+        };
+
     public:
         // Weight for reduction
         Field bf_m;
@@ -45,16 +61,31 @@ namespace ippl {
         /*!
          * Performs scatter operation of particle positions in field (weights) and
          * repartitions FieldLayout's global domain
+         * @tparam Shape the shape function used to scatter the particles
          * @tparam Attrib the particle attribute type (memory space must be accessible to field
          * memory)
          * @param R Weights to scatter
          * @param fl FieldLayout
          * @param isFirstRepartition boolean which tells whether to scatter or not
          */
-        template <typename Attrib>
+        template <typename Shape = CIC, typename Attrib>
         bool binaryRepartition(const Attrib& R, FieldLayout<Dim>& fl,
                                const bool& isFirstRepartition);
 
+        /*!
+         * Rebalances by shifting the cuts of the previous repartition towards the
+         * weighted medians instead of rebuilding the tree. Each cut keeps its axis
+         * and moves by at most maxShift cells, which bounds the data that has to
+         * migrate. Falls back to a full repartition if there is no previous tree.
+         * @tparam Shape the shape function used to scatter the particles
+         * @tparam Attrib the particle attribute type
+         * @param R Weights to scatter
+         * @param fl FieldLayout
+         * @param maxShift the maximum number of cells by which a cut may move
+         */
+        template <typename Shape = CIC, typename Attrib>
+        bool incrementalRepartition(const Attrib& R, FieldLayout<Dim>& fl, int maxShift);
+
         /*!
          * Find cutting axis as the longest axis of the field layout.
          * @param dom Domain to reduce
@@ -72,10 +103,24 @@ namespace ippl {
                                     NDIndex<Dim>& dom);
 
         /*!
-         * Find median of array
+         * Computes the local weight profiles of several domains along their cut
+         * axes in a single kernel, with one team reducing each plane
+         * @param profiles the concatenated profiles, resized to the total length of the
+         * cut axes; the profile of a domain starts after those of the preceding domains
+         * @param cutAxes the cut axis of each domain
+         * @param doms the domains to reduce
+         */
+        void perpendicularReduction(std::vector<Tf>& profiles,
+                                    const std::vector<unsigned int>& cutAxes,
+                                    const std::vector<NDIndex<Dim>>& doms);
+
+        /*!
+         * Find the weighted median of array, i.e. the position at which the given
+         * fraction of the total weight lies to the left
          * @param w Array of real numbers
+         * @param fraction the fraction of the weight left of the cut (default 0.5)
          */
-        int findMedian(std::vector<Tf>& w);
+        int findMedian(std::vector<Tf>& w, Tf fraction = 0.5);
 
         /*!
          * Splits the domain given by the iterator along the cut axis at the median,
@@ -85,19 +130,101 @@ namespace ippl {
          * @param it Iterator
          * @param cutAxis Index of cut axis
          * @param median Median
+         * @param leftProcs the number of ranks of the left part (default: half of them)
          */
         void cutDomain(std::vector<NDIndex<Dim>>& domains, std::vector<int>& procs, int it,
-                       int cutAxis, int median);
+                       int cutAxis, int median, int leftProcs = -1);
+
+        /*!
+         * Sets the weights of particles and cells used by the following
+         * repartitions, e.g. the costs measured by a CostModel. By default every
+         * particle has weight 1 and cells have no weight.
+         * @param particleWeight the weight of a particle
+         * @param cellWeight the weight of a cell
+         */
+        void setCostWeights(Tf particleWeight, Tf cellWeight) {
+            particleWeight_m = particleWeight;
+            cellWeight_m     = cellWeight;
+        }
+
+        /*!
+         * Sets the capacity of every rank, i.e. the work it completes per unit time
+         * relative to the others, e.g. measured by a CostModel. Each cut then
+         * divides the weight in proportion to the capacities of the ranks on both
+         * sides. By default, or with an empty list, all ranks are equally fast.
+         * @param capacities the capacity of each rank
+         */
+        void setRankCapacities(const std::vector<double>& capacities) {
+            capacities_m = capacities;
+        }
 
         /*!
-         * Scattering of particle positions in field using a CIC method
+         * Sets whether the cuts separate the ranks of different nodes first. A domain
+         * shared by the ranks of several nodes is then divided at the node boundary
+         * closest to the middle of its ranks, so that each node ends up with one
+         * compact part of the domain and the halo exchange between its ranks stays
+         * on the node. This assumes the ranks of a node are numbered consecutively.
+         * @param nodeAware whether to cut at node boundaries
+         */
+        void setNodeAware(bool nodeAware) {
+            nodeAware_m = nodeAware;
+            // The tree of the previous repartition has a different shape
+            cutAxes_m.clear();
+            cuts_m.clear();
+        }
+
+        /*!
+         * Scattering of particle positions in field, plus the weight of the cells
+         * @tparam Shape the particle shape function (NGP, CIC, TSC or PQS)
          * @tparam Attrib the particle attribute type (memory space must be accessible to field
          * memory)
          * @param r Weights
          */
-        template <typename Attrib>
+        template <typename Shape = CIC, typename Attrib>
         void scatterR(const Attrib& r);
 
+    private:
+        /*!
+         * Bisects the global domain of the layout with the weights in bf_m and
+         * updates the layout
+         * @param fl FieldLayout
+         * @param maxShift the maximum shift of the previous cuts, or -1 to rebuild the tree
+         */
+        bool bisect(FieldLayout<Dim>& fl, int maxShift);
+
+        /*!
+         * The number of ranks of the left part of a domain when it is cut
+         * @param nodeIds the node of each rank, empty unless the cuts are node-aware
+         * @param first the first rank of the domain
+         * @param procs the number of ranks of the domain
+         */
+        int leftProcs(const std::vector<int>& nodeIds, int first, int procs) const;
+
+        /*!
+         * The fraction of the capacity of a domain's ranks that falls to the ranks
+         * of its left part when it is cut
+         * @param first the first rank of the domain
+         * @param procs the number of ranks of the domain
+         * @param left the number of ranks of the left part
+         */
+        Tf leftFraction(int first, int procs, int left) const;
+
+        //! The cut axes of the last repartition, in the order of the cuts
+        std::vector<unsigned int> cutAxes_m;
+
+        //! The last cell left of each cut of the last repartition
+        std::vector<int> cuts_m;
+
+        //! The weights of a particle and of a cell (see setCostWeights)
+        Tf particleWeight_m = 1;
+        Tf cellWeight_m     = 0;
+
+        //! The capacities of the ranks (see setRankCapacities)
+        std::vector<double> capacities_m;
+
+        //! Whether the cuts follow node boundaries (see setNodeAware)
+        bool nodeAware_m = false;
+
     };  // class
 
 }  // namespace ippl
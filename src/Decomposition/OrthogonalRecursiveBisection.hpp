@@ -1,3 +1,8 @@
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+
+#include "Utility/IpplException.h"
 #include "Utility/IpplTimings.h"
 
 namespace ippl {
@@ -10,14 +15,11 @@ namespace ippl {
     }
 
     template <class Field, class Tp>
-    template <typename Attrib>
+    template <typename Shape, typename Attrib>
     bool OrthogonalRecursiveBisection<Field, Tp>::binaryRepartition(
         const Attrib& R, FieldLayout<Dim>& fl, const bool& isFirstRepartition) {
         // Timings
-        static IpplTimings::TimerRef tbasicOp       = IpplTimings::getTimer("basicOperations");
-        static IpplTimings::TimerRef tperpReduction = IpplTimings::getTimer("perpReduction");
-        static IpplTimings::TimerRef tallReduce     = IpplTimings::getTimer("allReduce");
-        static IpplTimings::TimerRef tscatter       = IpplTimings::getTimer("scatterR");
+        static IpplTimings::TimerRef tscatter = IpplTimings::getTimer("scatterR");
 
         // Scattering of particle positions in field
         // In case of first repartition we know the density from the
@@ -27,16 +29,44 @@ namespace ippl {
         // before it.
         IpplTimings::startTimer(tscatter);
         if (!isFirstRepartition) {
-            scatterR(R);
+            scatterR<Shape>(R);
         }
 
         IpplTimings::stopTimer(tscatter);
 
+        return bisect(fl, -1);
+    }
+
+    template <class Field, class Tp>
+    template <typename Shape, typename Attrib>
+    bool OrthogonalRecursiveBisection<Field, Tp>::incrementalRepartition(
+        const Attrib& R, FieldLayout<Dim>& fl, int maxShift) {
+        static IpplTimings::TimerRef tscatter = IpplTimings::getTimer("scatterR");
+        IpplTimings::startTimer(tscatter);
+        scatterR<Shape>(R);
+        IpplTimings::stopTimer(tscatter);
+
+        // Without a tree for this number of ranks there are no cuts to shift
+        const bool hasTree = cuts_m.size() + 1 == static_cast<size_t>(fl.comm.size());
+        return bisect(fl, hasTree ? maxShift : -1);
+    }
+
+    template <class Field, class Tp>
+    bool OrthogonalRecursiveBisection<Field, Tp>::bisect(FieldLayout<Dim>& fl, int maxShift) {
+        static IpplTimings::TimerRef tbasicOp       = IpplTimings::getTimer("basicOperations");
+        static IpplTimings::TimerRef tperpReduction = IpplTimings::getTimer("perpReduction");
+        static IpplTimings::TimerRef tallReduce     = IpplTimings::getTimer("allReduce");
+
         IpplTimings::startTimer(tbasicOp);
 
         // Get number of ranks
         auto& comm = fl.comm;
         int nprocs = comm.size();
+        if (!capacities_m.empty() && capacities_m.size() != static_cast<size_t>(nprocs)) {
+            throw IpplException("OrthogonalRecursiveBisection::bisect",
+                                "The number of rank capacities must match the number of ranks");
+        }
+        const std::vector<int> nodeIds = nodeAware_m ? comm.nodeIds() : std::vector<int>{};
 
         // Start with whole domain and total number of nodes
         std::vector<NDIndex<Dim>> domains = {fl.getDomain()};
@@ -45,27 +75,38 @@ namespace ippl {
         // Arrays for reduction
         std::vector<Tf> reduced, reducedRank;
 
-        // Start recursive repartition loop
-        unsigned int it = 0;
-        int maxprocs    = nprocs;
+        // The cut axes and positions of the new tree, in the order of the cuts
+        const bool incremental = maxShift >= 0;
+        std::vector<unsigned int> treeAxes;
+        std::vector<int> treeCuts;
         IpplTimings::stopTimer(tbasicOp);
 
-        while (maxprocs > 1) {
-            // Find cut axis
+        // All domains of a bisection level are cut together, with one reduction
+        // of their concatenated profiles per level
+        std::vector<size_t> active;
+        if (nprocs > 1) {
+            active.push_back(0);
+        }
+        while (!active.empty()) {
+            // Find cut axes
             IpplTimings::startTimer(tbasicOp);
-            int cutAxis = findCutAxis(domains[it]);
+            std::vector<NDIndex<Dim>> activeDomains;
+            std::vector<unsigned int> cutAxes;
+            const size_t firstCut = treeCuts.size();
+            for (size_t k : active) {
+                activeDomains.push_back(domains[k]);
+                // An incremental repartition keeps the axes of the existing tree
+                cutAxes.push_back(incremental ? cutAxes_m[treeAxes.size()]
+                                              : findCutAxis(domains[k]));
+                treeAxes.push_back(cutAxes.back());
+            }
+            treeCuts.resize(treeAxes.size());
             IpplTimings::stopTimer(tbasicOp);
 
-            // Reserve space
-            IpplTimings::startTimer(tperpReduction);
-            reduced.resize(domains[it][cutAxis].length());
-            reducedRank.resize(domains[it][cutAxis].length());
-
-            std::fill(reducedRank.begin(), reducedRank.end(), 0.0);
-            std::fill(reduced.begin(), reduced.end(), 0.0);
-
             // Peform reduction with field of weights and communicate to the other ranks
-            perpendicularReduction(reducedRank, cutAxis, domains[it]);
+            IpplTimings::startTimer(tperpReduction);
+            perpendicularReduction(reducedRank, cutAxes, activeDomains);
+            reduced.resize(reducedRank.size());
             IpplTimings::stopTimer(tperpReduction);
 
             // Communicate to all the reduced weights
@@ -73,32 +114,43 @@ namespace ippl {
             comm.allreduce(reducedRank.data(), reduced.data(), reducedRank.size(), std::plus<Tf>());
             IpplTimings::stopTimer(tallReduce);
 
-            // Find median of reduced weights
+            // Find the median of each profile and cut the domains; going backwards
+            // keeps the indices of the domains not yet cut valid
             IpplTimings::startTimer(tbasicOp);
-            // Initialize median to some value (1 is lower bound value)
-            int median = 1;
-            median     = findMedian(reduced);
-            IpplTimings::stopTimer(tbasicOp);
+            size_t offset = reduced.size();
+            for (size_t k = active.size(); k-- > 0;) {
+                const size_t length = activeDomains[k][cutAxes[k]].length();
+                offset -= length;
+                std::vector<Tf> profile(reduced.begin() + offset,
+                                        reduced.begin() + offset + length);
+                // The domains left of this one are not cut yet, so their ranks
+                // precede the ranks of this domain
+                const int first   = std::accumulate(procs.begin(), procs.begin() + active[k], 0);
+                const int left    = leftProcs(nodeIds, first, procs[active[k]]);
+                const Tf fraction = leftFraction(first, procs[active[k]], left);
+                int median        = findMedian(profile, fraction);
+
+                const Index& axis = activeDomains[k][cutAxes[k]];
+                if (incremental && length >= 4) {
+                    // Move the existing cut towards the median by at most maxShift,
+                    // keeping at least two cells on each side
+                    const int previous = cuts_m[firstCut + k] - axis.first();
+                    median = std::clamp(median, previous - maxShift, previous + maxShift);
+                    median = std::clamp(median, 1, static_cast<int>(length) - 3);
+                }
+                treeCuts[firstCut + k] = median + axis.first();
 
-            // Cut domains and procs
-            IpplTimings::startTimer(tbasicOp);
-            cutDomain(domains, procs, it, cutAxis, median);
-
-            // Update max procs
-            maxprocs = 0;
-            for (unsigned int i = 0; i < procs.size(); i++) {
-                if (procs[i] > maxprocs) {
-                    maxprocs = procs[i];
-                    it       = i;
+                cutDomain(domains, procs, active[k], cutAxes[k], median, left);
+            }
+
+            // The next level consists of the domains still shared by several ranks
+            active.clear();
+            for (size_t k = 0; k < procs.size(); k++) {
+                if (procs[k] > 1) {
+                    active.push_back(k);
                 }
             }
             IpplTimings::stopTimer(tbasicOp);
-
-            // Clear all arrays
-            IpplTimings::startTimer(tperpReduction);
-            reduced.clear();
-            reducedRank.clear();
-            IpplTimings::stopTimer(tperpReduction);
         }
 
         // Check that no plane was obtained in the repartition
@@ -111,6 +163,9 @@ namespace ippl {
             }
         }
 
+        cutAxes_m = std::move(treeAxes);
+        cuts_m    = std::move(treeCuts);
+
         // Update FieldLayout with new indices
         fl.updateLayout(domains);
 
@@ -133,74 +188,139 @@ namespace ippl {
     template <class Field, class Tp>
     void OrthogonalRecursiveBisection<Field, Tp>::perpendicularReduction(
         std::vector<Tf>& rankWeights, unsigned int cutAxis, NDIndex<Dim>& dom) {
-        // Check if domains overlap, if not no need for reduction
+        perpendicularReduction(rankWeights, std::vector<unsigned int>{cutAxis},
+                               std::vector<NDIndex<Dim>>{dom});
+    }
+
+    template <class Field, class Tp>
+    void OrthogonalRecursiveBisection<Field, Tp>::perpendicularReduction(
+        std::vector<Tf>& profiles, const std::vector<unsigned int>& cutAxes,
+        const std::vector<NDIndex<Dim>>& doms) {
         NDIndex<Dim> lDom = bf_m.getOwned();
-        if (lDom[cutAxis].first() > dom[cutAxis].last()
-            || lDom[cutAxis].last() < dom[cutAxis].first()) {
+        int nghost        = bf_m.getNghost();
+
+        // Collect the planes of the local part of each domain
+        std::vector<PlaneRange> planes;
+        size_t offset = 0;
+        for (size_t k = 0; k < doms.size(); ++k) {
+            const NDIndex<Dim>& dom = doms[k];
+            const unsigned cutAxis  = cutAxes[k];
+
+            PlaneRange plane;
+            bool overlaps = true;
+            for (unsigned d = 0; d < Dim; d++) {
+                int inf = std::max(lDom[d].first(), dom[d].first()) - lDom[d].first() + nghost;
+                int sup = std::min(lDom[d].last(), dom[d].last()) - lDom[d].first() + nghost;
+                // inf and sup bounds must be within the domain to reduce, if not no need to reduce
+                overlaps &= sup >= inf;
+
+                plane.begin[d] = inf;
+                // The +1 is for Kokkos loop
+                plane.end[d] = sup + 1;
+            }
+
+            if (overlaps) {
+                const int first = plane.begin[cutAxis];
+                const int last  = plane.end[cutAxis];
+                // Position of the first local plane in the profile of the domain
+                const size_t start = std::max(lDom[cutAxis].first() - dom[cutAxis].first(), 0);
+                for (int i = first; i < last; i++) {
+                    plane.begin[cutAxis] = i;
+                    plane.end[cutAxis]   = i + 1;
+                    plane.entry          = offset + start + (i - first);
+                    planes.push_back(plane);
+                }
+            }
+            offset += dom[cutAxis].length();
+        }
+
+        profiles.assign(offset, Tf(0));
+        if (planes.empty()) {
             return;
         }
 
-        // Get field's local weights
-        int nghost      = bf_m.getNghost();
-        const auto data = bf_m.getView();
+        using memory_space = typename Field::memory_space;
+        using plane_view   = Kokkos::View<PlaneRange*, memory_space>;
+        using weight_view  = Kokkos::View<Tf*, memory_space>;
 
-        // Determine the iteration bounds of the reduction
-        int cutAxisFirst =
-            std::max(lDom[cutAxis].first(), dom[cutAxis].first()) - lDom[cutAxis].first() + nghost;
-        int cutAxisLast =
-            std::min(lDom[cutAxis].last(), dom[cutAxis].last()) - lDom[cutAxis].first() + nghost;
+        plane_view dPlanes("ORB planes", planes.size());
+        Kokkos::deep_copy(dPlanes, Kokkos::View<PlaneRange*, Kokkos::HostSpace,
+                                                Kokkos::MemoryUnmanaged>(planes.data(),
+                                                                         planes.size()));
+        weight_view weights("ORB weights", offset);
 
-        // Set iterator for where to write in the reduced array
-        unsigned int arrayStart = 0;
-        if (dom[cutAxis].first() < lDom[cutAxis].first()) {
-            arrayStart = lDom[cutAxis].first() - dom[cutAxis].first();
-        }
+        const auto data = bf_m.getView();
 
-        // Find all the perpendicular axes
-        using exec_space = typename Field::execution_space;
-        using index_type = typename RangePolicy<Dim, exec_space>::index_type;
-        Kokkos::Array<index_type, Dim> begin, end;
-        for (unsigned d = 0; d < Dim; d++) {
-            if (d == cutAxis) {
-                continue;
-            }
+        using team_policy = Kokkos::TeamPolicy<exec_space>;
+        using member_type = typename team_policy::member_type;
 
-            int inf = std::max(lDom[d].first(), dom[d].first()) - lDom[d].first() + nghost;
-            int sup = std::min(lDom[d].last(), dom[d].last()) - lDom[d].first() + nghost;
-            // inf and sup bounds must be within the domain to reduce, if not no need to reduce
-            if (sup < inf) {
-                return;
-            }
-
-            begin[d] = inf;
-            // The +1 is for Kokkos loop
-            end[d] = sup + 1;
-        }
+        // One team per plane reduces the cells of the plane
+        Kokkos::parallel_for(
+            "ORB weight reduction", team_policy(planes.size(), Kokkos::AUTO),
+            KOKKOS_LAMBDA(const member_type& team) {
+                const PlaneRange& plane = dPlanes(team.league_rank());
 
-        // Iterate along cutAxis
-        for (int i = cutAxisFirst; i <= cutAxisLast; i++) {
-            begin[cutAxis] = i;
-            end[cutAxis]   = i + 1;
+                size_t nCells = 1;
+                for (unsigned d = 0; d < Dim; d++) {
+                    nCells *= plane.end[d] - plane.begin[d];
+                }
 
-            // Reducing over perpendicular plane defined by cutAxis
-            Tf tempRes = Tf(0);
+                Tf weight = 0;
+                Kokkos::parallel_reduce(
+                    Kokkos::TeamThreadRange(team, nCells),
+                    [&](const size_t cell, Tf& w) {
+                        index_array_type args;
+                        size_t rest = cell;
+                        for (unsigned d = 0; d < Dim; d++) {
+                            const size_t extent = plane.end[d] - plane.begin[d];
+                            args[d]             = plane.begin[d] + rest % extent;
+                            rest /= extent;
+                        }
+                        w += apply(data, args);
+                    },
+                    Kokkos::Sum<Tf>(weight));
+
+                Kokkos::single(Kokkos::PerTeam(team), [&]() {
+                    weights(plane.entry) = weight;
+                });
+            });
 
-            using index_array_type = typename RangePolicy<Dim, exec_space>::index_array_type;
-            ippl::parallel_reduce(
-                "ORB weight reduction", createRangePolicy<Dim, exec_space>(begin, end),
-                KOKKOS_LAMBDA(const index_array_type& args, Tf& weight) {
-                    weight += apply(data, args);
-                },
-                Kokkos::Sum<Tf>(tempRes));
+        Kokkos::deep_copy(
+            Kokkos::View<Tf*, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(profiles.data(), offset),
+            weights);
+    }
 
-            Kokkos::fence();
+    template <class Field, class Tp>
+    int OrthogonalRecursiveBisection<Field, Tp>::leftProcs(const std::vector<int>& nodeIds,
+                                                           int first, int procs) const {
+        // Among the node boundaries inside the ranks of the domain, take the one
+        // closest to the middle
+        int left = -1;
+        for (int rank = first + 1; rank < first + procs && !nodeIds.empty(); ++rank) {
+            const int candidate = rank - first;
+            if (nodeIds[rank] != nodeIds[rank - 1]
+                && (left < 0 || std::abs(2 * candidate - procs) < std::abs(2 * left - procs))) {
+                left = candidate;
+            }
+        }
+        return left < 0 ? procs / 2 : left;
+    }
 
-            rankWeights[arrayStart++] = tempRes;
+    template <class Field, class Tp>
+    typename OrthogonalRecursiveBisection<Field, Tp>::Tf
+    OrthogonalRecursiveBisection<Field, Tp>::leftFraction(int first, int procs, int left) const {
+        if (capacities_m.empty()) {
+            // Halving the ranks keeps the plain median
+            return left == procs / 2 ? Tf(0.5) : Tf(left) / procs;
         }
+        auto begin      = capacities_m.begin() + first;
+        double leftCap  = std::accumulate(begin, begin + left, 0.0);
+        double totalCap = std::accumulate(begin + left, begin + procs, leftCap);
+        return totalCap > 0 ? leftCap / totalCap : Tf(left) / procs;
     }
 
     template <class Field, class Tp>
-    int OrthogonalRecursiveBisection<Field, Tp>::findMedian(std::vector<Tf>& w) {
+    int OrthogonalRecursiveBisection<Field, Tp>::findMedian(std::vector<Tf>& w, Tf fraction) {
         // Special case when array must be cut in half in order to not have planes
         if (w.size() == 4) {
             return 1;
@@ -208,8 +328,8 @@ namespace ippl {
         // Get total sum of array
         Tf tot = std::accumulate(w.begin(), w.end(), Tf(0));
 
-        // Find position of median as half of total in array
-        Tf half = 0.5 * tot;
+        // Find position of median as the given fraction of total in array
+        Tf half = fraction * tot;
         Tf curr = Tf(0);
         // Do not need to iterate to full extent since it must not give planes
         for (unsigned int i = 0; i < w.size() - 1; i++) {
@@ -221,7 +341,7 @@ namespace ippl {
                 }
                 Tf previous = curr - w[i];
                 // curr - half < half - previous
-                if ((curr + previous) <= tot
+                if ((curr + previous) <= 2 * half
                     && curr != half) {  // if true then take current i, otherwise i-1
                     if (i == w.size() - 2) {
                         return (i - 1);
@@ -240,60 +360,30 @@ namespace ippl {
     template <class Field, class Tp>
     void OrthogonalRecursiveBisection<Field, Tp>::cutDomain(std::vector<NDIndex<Dim>>& domains,
                                                             std::vector<int>& procs, int it,
-                                                            int cutAxis, int median) {
+                                                            int cutAxis, int median,
+                                                            int leftProcs) {
         // Cut domains[it] in half at median along cutAxis
         NDIndex<Dim> leftDom, rightDom;
         domains[it].split(leftDom, rightDom, cutAxis, median + domains[it][cutAxis].first());
         domains[it] = leftDom;
         domains.insert(domains.begin() + it + 1, rightDom);
 
-        // Cut procs in half
+        // Cut procs in half, unless told otherwise
         int temp  = procs[it];
-        procs[it] = procs[it] / 2;
+        procs[it] = leftProcs < 0 ? procs[it] / 2 : leftProcs;
         procs.insert(procs.begin() + it + 1, temp - procs[it]);
     }
 
     template <class Field, class Tp>
-    template <typename Attrib>
+    template <typename Shape, typename Attrib>
     void OrthogonalRecursiveBisection<Field, Tp>::scatterR(const Attrib& r) {
-        using vector_type = typename mesh_type::vector_type;
-        static_assert(
-            Kokkos::SpaceAccessibility<typename Attrib::memory_space,
-                                       typename Field::memory_space>::accessible,
-            "Particle attribute memory space must be accessible from ORB field memory space");
-
-        // Reset local field
-        bf_m = 0.0;
-        // Get local data
-        auto view                      = bf_m.getView();
-        const mesh_type& mesh          = bf_m.get_mesh();
-        const FieldLayout<Dim>& layout = bf_m.getLayout();
-        const NDIndex<Dim>& lDom       = layout.getLocalNDIndex();
-        const int nghost               = bf_m.getNghost();
-
-        // Get spacings
-        const vector_type& dx     = mesh.getMeshSpacing();
-        const vector_type& origin = mesh.getOrigin();
-        const vector_type invdx   = 1.0 / dx;
-
-        using policy_type = Kokkos::RangePolicy<size_t, typename Field::execution_space>;
+        detail::scatterWeights<Shape>(bf_m, r, particleWeight_m,
+                                      "OrthogonalRecursiveBisection::scatterR");
 
-        Kokkos::parallel_for(
-            "ParticleAttrib::scatterR", policy_type(0, r.getParticleCount()),
-            KOKKOS_LAMBDA(const size_t idx) {
-                // Find nearest grid point
-                Vector<Tp, Dim> l      = (r(idx) - origin) * invdx + 0.5;
-                Vector<int, Dim> index = l;
-                Vector<Tf, Dim> whi    = l - index;
-                Vector<Tf, Dim> wlo    = 1.0 - whi;
-
-                Vector<size_t, Dim> args = index - lDom.first() + nghost;
-
-                // Scatter
-                scatterToField(std::make_index_sequence<1 << Dim>{}, view, wlo, whi, args);
-            });
-
-        bf_m.accumulateHalo();
+        // The cells are added after the halo exchange so that ghost cells do not count
+        if (cellWeight_m != 0) {
+            bf_m = bf_m + cellWeight_m;
+        }
     }
 
 }  // namespace ippl
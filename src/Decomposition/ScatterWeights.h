@@ -0,0 +1,78 @@
+//
+// Function scatterWeights
+//   Deposits one weight per particle onto the weight field of a partitioner.
+//   Shared by the ORB and the space-filling curve, which both balance the
+//   weights of the cells of the global domain.
+//
+#ifndef IPPL_SCATTER_WEIGHTS_H
+#define IPPL_SCATTER_WEIGHTS_H
+
+#include <string>
+
+#include "Particle/ParticleAttrib.h"
+#include "Utility/IpplException.h"
+
+namespace ippl {
+    namespace detail {
+
+        /*!
+         * Resets the field and scatters a constant weight per particle into it,
+         * including the contributions of the ghost cells of neighbouring ranks
+         * @tparam Shape the particle shape function (NGP, CIC, TSC or PQS)
+         * @param field the weight field
+         * @param r particle positions (memory space must be accessible to field memory)
+         * @param weight the weight of one particle
+         * @param caller name of the calling function for error messages
+         */
+        template <typename Shape, typename Field, typename Attrib>
+        void scatterWeights(Field& field, const Attrib& r, typename Field::value_type weight,
+                            const std::string& caller) {
+            constexpr unsigned Dim = Field::dim;
+            using Tf               = typename Field::value_type;
+            using mesh_type        = typename Field::Mesh_t;
+            using vector_type      = typename mesh_type::vector_type;
+            static_assert(
+                Kokkos::SpaceAccessibility<typename Attrib::memory_space,
+                                           typename Field::memory_space>::accessible,
+                "Particle attribute memory space must be accessible from the field memory space");
+
+            // Reset local field
+            field = 0.0;
+            // Get local data
+            auto view                      = field.getView();
+            const mesh_type& mesh          = field.get_mesh();
+            const FieldLayout<Dim>& layout = field.getLayout();
+            const NDIndex<Dim>& lDom       = layout.getLocalNDIndex();
+            const int nghost               = field.getNghost();
+            if (nghost < Shape::ghostCells) {
+                throw IpplException(caller, "Too few ghost layers for the shape function");
+            }
+
+            // Get spacings
+            const vector_type& dx     = mesh.getMeshSpacing();
+            const vector_type& origin = mesh.getOrigin();
+            const vector_type invdx   = 1.0 / dx;
+
+            // Offset from global cell indices to view indices
+            Vector<int, Dim> shift;
+            for (unsigned d = 0; d < Dim; ++d) {
+                shift[d] = nghost - lDom[d].first();
+            }
+
+            using policy_type = Kokkos::RangePolicy<size_t, typename Field::execution_space>;
+
+            Kokkos::parallel_for(
+                caller, policy_type(0, r.getParticleCount()), KOKKOS_LAMBDA(const size_t idx) {
+                    const Stencil<Shape, Tf, Dim> st(Vector<Tf, Dim>((r(idx) - origin) * invdx),
+                                                     shift);
+
+                    // Scatter
+                    scatterToField(st, view, weight);
+                });
+
+            field.accumulateHalo();
+        }
+    }  // namespace detail
+}  // namespace ippl
+
+#endif  // IPPL_SCATTER_WEIGHTS_H
@@ -0,0 +1,140 @@
+//
+// Class SpaceFillingCurve for Domain Decomposition
+//
+// Domain decomposition along a space-filling curve (Hilbert or Morton). The
+// global domain is cut into bricks of cells, the bricks are ordered along the
+// curve and the weighted prefix sum over that ordering is split into chunks
+// of equal cost. A single global reduction of the brick weights replaces the
+// log2(P) rounds of ORB, and the balance does not degrade for clustered
+// weights. The resulting rank domains are unions of bricks and need not be
+// boxes, so they cannot be described by a FieldLayout; the partitioner only
+// reports the owned bricks and regions of each rank.
+//
+
+#ifndef IPPL_SPACE_FILLING_CURVE_H
+#define IPPL_SPACE_FILLING_CURVE_H
+
+#include <vector>
+
+#include "Decomposition/ScatterWeights.h"
+#include "FieldLayout/FieldLayout.h"
+#include "Index/Index.h"
+#include "Index/NDIndex.h"
+#include "Particle/ParticleAttrib.h"
+#include "Region/NDRegion.h"
+#include "Utility/SpaceFillingCurveKeys.h"
+
+namespace ippl {
+    /*
+     * @class SpaceFillingCurve
+     * @tparam Field the field type
+     * @tparam Tp type of particle position. If not specified, it will be equal to the field's type
+     */
+    template <class Field, class Tp = typename Field::value_type>
+    class SpaceFillingCurve {
+        constexpr static unsigned Dim = Field::dim;
+        using mesh_type               = typename Field::Mesh_t;
+        using Tf                      = typename Field::value_type;
+        using memory_space            = typename Field::memory_space;
+        using execution_space         = typename Field::execution_space;
+
+    public:
+        using key_type = detail::sfc_key_type;
+
+        // Weight for reduction
+        Field bf_m;
+
+        /*!
+         * @param curve the curve along which the bricks are ordered
+         * @param bricksPerRank the number of bricks per rank the domain is cut into;
+         *        more bricks give a finer balance at the cost of more irregular domains
+         */
+        SpaceFillingCurve(CurveType curve = HILBERT, unsigned bricksPerRank = 16)
+            : curve_m(curve)
+            , bricksPerRank_m(bricksPerRank) {}
+
+        /*!
+         * Initialize member field with mesh and field layout and set up the bricks
+         * @param fl
+         * @param mesh Mesh
+         * @param rho Density field
+         */
+        void initialize(FieldLayout<Dim>& fl, mesh_type& mesh, const Field& rho);
+
+        /*!
+         * Performs scatter operation of particle positions in field (weights) and
+         * assigns each brick to a rank such that every rank owns a contiguous piece
+         * of the curve carrying the same share of the total weight
+         * @tparam Shape the shape function used to scatter the particles
+         * @tparam Attrib the particle attribute type (memory space must be accessible to field
+         * memory)
+         * @param R Weights to scatter
+         * @param isFirstRepartition boolean which tells whether to scatter or not
+         */
+        template <typename Shape = CIC, typename Attrib>
+        bool repartition(const Attrib& R, const bool& isFirstRepartition);
+
+        /*!
+         * Scattering of particle positions in field
+         * @tparam Shape the particle shape function (NGP, CIC, TSC or PQS)
+         * @tparam Attrib the particle attribute type (memory space must be accessible to field
+         * memory)
+         * @param r Weights
+         */
+        template <typename Shape = CIC, typename Attrib>
+        void scatterR(const Attrib& r);
+
+        //! The owning rank of each brick, in linear brick order
+        const std::vector<int>& getBrickOwners() const { return owners_m; }
+
+        /*!
+         * Domain of a rank as a list of bricks
+         * @param rank the rank
+         */
+        std::vector<NDIndex<Dim>> getOwnedBricks(int rank) const;
+
+        /*!
+         * Domain of a rank as a list of regions in physical space, as used by RegionLayout
+         * @param rank the rank
+         */
+        std::vector<NDRegion<Tp, Dim>> getOwnedRegions(int rank) const;
+
+        //! The brick weights from the last repartition, in linear brick order
+        const std::vector<Tf>& getBrickWeights() const { return weights_m; }
+
+    private:
+        /*!
+         * Cuts the global domain into roughly bricksPerRank_m bricks per rank
+         * and sorts them along the curve
+         */
+        void setupBricks();
+
+        /*!
+         * Sums the local weights of each brick and reduces them over all ranks
+         */
+        void reduceBrickWeights();
+
+        CurveType curve_m;
+        unsigned bricksPerRank_m;
+
+        NDIndex<Dim> gDomain_m;
+        mpi::Communicator comm_m;
+
+        // Brick edge length and number of bricks per dimension
+        Vector<int, Dim> brickSize_m;
+        Vector<int, Dim> nBricks_m;
+        unsigned bits_m = 1;
+
+        std::vector<NDIndex<Dim>> bricks_m;
+        std::vector<key_type> keys_m;
+        std::vector<std::size_t> order_m;
+        std::vector<Tf> weights_m;
+        std::vector<int> owners_m;
+        std::vector<key_type> splitters_m;
+    };  // class
+
+}  // namespace ippl
+
+#include "Decomposition/SpaceFillingCurve.hpp"
+
+#endif  // IPPL_SPACE_FILLING_CURVE_H
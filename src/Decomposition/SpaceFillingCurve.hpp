@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <numeric>
+
+#include "Utility/IpplException.h"
+#include "Utility/IpplTimings.h"
+
+namespace ippl {
+
+    template <class Field, class Tp>
+    void SpaceFillingCurve<Field, Tp>::initialize(FieldLayout<Dim>& fl, mesh_type& mesh,
+                                                  const Field& rho) {
+        bf_m.initialize(mesh, fl);
+        bf_m = rho;
+
+        gDomain_m = fl.getDomain();
+        comm_m    = fl.comm;
+
+        setupBricks();
+    }
+
+    template <class Field, class Tp>
+    void SpaceFillingCurve<Field, Tp>::setupBricks() {
+        // Halve the longest brick edge until there are enough bricks
+        const std::size_t target = std::size_t(comm_m.size()) * bricksPerRank_m;
+        for (unsigned d = 0; d < Dim; ++d) {
+            brickSize_m[d] = gDomain_m[d].length();
+            nBricks_m[d]   = 1;
+        }
+
+        std::size_t nTotal = 1;
+        while (nTotal < target) {
+            unsigned dmax = 0;
+            for (unsigned d = 1; d < Dim; ++d) {
+                if (brickSize_m[d] > brickSize_m[dmax]) {
+                    dmax = d;
+                }
+            }
+            if (brickSize_m[dmax] == 1) {
+                break;
+            }
+            brickSize_m[dmax] = (brickSize_m[dmax] + 1) / 2;
+
+            nTotal = 1;
+            for (unsigned d = 0; d < Dim; ++d) {
+                nBricks_m[d] = (gDomain_m[d].length() + brickSize_m[d] - 1) / brickSize_m[d];
+                nTotal *= nBricks_m[d];
+            }
+        }
+
+        bits_m = 1;
+        for (unsigned d = 0; d < Dim; ++d) {
+            bits_m = std::max(bits_m, detail::bitsFor(nBricks_m[d]));
+        }
+        if (bits_m * Dim > 8 * sizeof(key_type)) {
+            throw IpplException("SpaceFillingCurve::setupBricks",
+                                "Too many bricks for a 64-bit curve key.");
+        }
+
+        // Enumerate the bricks with the first dimension running fastest
+        bricks_m.resize(nTotal);
+        keys_m.resize(nTotal);
+        for (std::size_t b = 0; b < nTotal; ++b) {
+            std::size_t rem = b;
+            Vector<key_type, Dim> coords;
+            NDIndex<Dim> brick;
+            for (unsigned d = 0; d < Dim; ++d) {
+                coords[d] = rem % nBricks_m[d];
+                rem /= nBricks_m[d];
+                int first = gDomain_m[d].first() + coords[d] * brickSize_m[d];
+                int last  = std::min(first + brickSize_m[d] - 1, gDomain_m[d].last());
+                brick[d]  = Index(first, last);
+            }
+            bricks_m[b] = brick;
+            keys_m[b]   = detail::curveKey<Dim>(curve_m, coords, bits_m);
+        }
+
+        order_m.resize(nTotal);
+        std::iota(order_m.begin(), order_m.end(), 0);
+        std::sort(order_m.begin(), order_m.end(), [&](std::size_t a, std::size_t b) {
+            return keys_m[a] < keys_m[b];
+        });
+
+        weights_m.assign(nTotal, Tf(0));
+        owners_m.assign(nTotal, 0);
+    }
+
+    template <class Field, class Tp>
+    void SpaceFillingCurve<Field, Tp>::reduceBrickWeights() {
+        using weight_view = Kokkos::View<Tf*, memory_space>;
+        weight_view dWeights("SFC brick weights", bricks_m.size());
+
+        const NDIndex<Dim>& lDom = bf_m.getOwned();
+        const int nghost         = bf_m.getNghost();
+        const auto data          = bf_m.getView();
+
+        Vector<int, Dim> offset, brickSize = brickSize_m, nBricks = nBricks_m;
+        for (unsigned d = 0; d < Dim; ++d) {
+            offset[d] = lDom[d].first() - gDomain_m[d].first() - nghost;
+        }
+
+        using index_array_type = typename RangePolicy<Dim, execution_space>::index_array_type;
+        ippl::parallel_for(
+            "SpaceFillingCurve::reduceBrickWeights", bf_m.getFieldRangePolicy(),
+            KOKKOS_LAMBDA(const index_array_type& args) {
+                std::size_t b      = 0;
+                std::size_t stride = 1;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    b += ((args[d] + offset[d]) / brickSize[d]) * stride;
+                    stride *= nBricks[d];
+                }
+                Kokkos::atomic_add(&dWeights(b), apply(data, args));
+            });
+
+        auto hWeights = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), dWeights);
+        std::copy(hWeights.data(), hWeights.data() + hWeights.size(), weights_m.begin());
+
+        comm_m.allreduce(weights_m.data(), weights_m.size(), std::plus<Tf>());
+    }
+
+    template <class Field, class Tp>
+    template <typename Shape, typename Attrib>
+    bool SpaceFillingCurve<Field, Tp>::repartition(const Attrib& R,
+                                                   const bool& isFirstRepartition) {
+        static IpplTimings::TimerRef tscatter   = IpplTimings::getTimer("scatterR");
+        static IpplTimings::TimerRef treduce    = IpplTimings::getTimer("sfcReduction");
+        static IpplTimings::TimerRef tpartition = IpplTimings::getTimer("sfcPartition");
+
+        // As in ORB, the first repartition uses the analytical density
+        IpplTimings::startTimer(tscatter);
+        if (!isFirstRepartition) {
+            scatterR<Shape>(R);
+        }
+        IpplTimings::stopTimer(tscatter);
+
+        IpplTimings::startTimer(treduce);
+        reduceBrickWeights();
+        IpplTimings::stopTimer(treduce);
+
+        IpplTimings::startTimer(tpartition);
+        const int nprocs     = comm_m.size();
+        const std::size_t nb = order_m.size();
+
+        Tf total = std::accumulate(weights_m.begin(), weights_m.end(), Tf(0));
+
+        // Each brick goes to the rank whose share of the prefix sum contains the
+        // brick's midpoint; without any weight, split the curve by brick count
+        Tf prefix = 0;
+        splitters_m.assign(nprocs + 1, keys_m[order_m[nb - 1]] + 1);
+        int prev = -1;
+        for (std::size_t k = 0; k < nb; ++k) {
+            const std::size_t b = order_m[k];
+            int owner;
+            if (total > 0) {
+                owner = static_cast<int>((prefix + 0.5 * weights_m[b]) / total * nprocs);
+            } else {
+                owner = static_cast<int>(k * nprocs / nb);
+            }
+            owner       = std::min(owner, nprocs - 1);
+            owners_m[b] = owner;
+            prefix += weights_m[b];
+
+            for (int r = prev + 1; r <= owner; ++r) {
+                splitters_m[r] = keys_m[b];
+            }
+            prev = owner;
+        }
+
+        IpplTimings::stopTimer(tpartition);
+
+        // Every rank must own some part of the curve
+        return prev == nprocs - 1
+               && std::adjacent_find(splitters_m.begin(), splitters_m.end() - 1)
+                      == splitters_m.end() - 1;
+    }
+
+    template <class Field, class Tp>
+    auto SpaceFillingCurve<Field, Tp>::getOwnedBricks(int rank) const
+        -> std::vector<NDIndex<Dim>> {
+        std::vector<NDIndex<Dim>> owned;
+        for (const std::size_t b : order_m) {
+            if (owners_m[b] == rank) {
+                owned.push_back(bricks_m[b]);
+            }
+        }
+        return owned;
+    }
+
+    template <class Field, class Tp>
+    auto SpaceFillingCurve<Field, Tp>::getOwnedRegions(int rank) const
+        -> std::vector<NDRegion<Tp, Dim>> {
+        using vector_type = typename mesh_type::vector_type;
+
+        const mesh_type& mesh     = bf_m.get_mesh();
+        const vector_type& dx     = mesh.getMeshSpacing();
+        const vector_type& origin = mesh.getOrigin();
+
+        std::vector<NDRegion<Tp, Dim>> regions;
+        for (const auto& brick : getOwnedBricks(rank)) {
+            NDRegion<Tp, Dim> region;
+            for (unsigned d = 0; d < Dim; ++d) {
+                const int first = brick[d].first() - gDomain_m[d].first();
+                const int last  = brick[d].last() - gDomain_m[d].first() + 1;
+                region[d]       = PRegion<Tp>(origin[d] + first * dx[d], origin[d] + last * dx[d]);
+            }
+            regions.push_back(region);
+        }
+        return regions;
+    }
+
+    template <class Field, class Tp>
+    template <typename Shape, typename Attrib>
+    void SpaceFillingCurve<Field, Tp>::scatterR(const Attrib& r) {
+        detail::scatterWeights<Shape>(bf_m, r, Tf(1), "SpaceFillingCurve::scatterR");
+    }
+
+}  // namespace ippl
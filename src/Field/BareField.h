@@ -9,9 +9,11 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 
 #include "Types/IpplTypes.h"
 
+#include "Utility/BatchedReduction.h"
 #include "Utility/IpplInfo.h"
 #include "Utility/PAssert.h"
 #include "Utility/ViewUtils.h"
@@ -103,6 +105,16 @@ namespace ippl {
         // ML
         void updateLayout(Layout_t&, int nghost = 1);
 
+        /*!
+         * Changes the layout like updateLayout, but keeps the values of the owned
+         * cells. Each rank sends the intersections of its old local domain with the
+         * new local domains of the other ranks. The halo cells are not filled.
+         * Use ippl::redistribute to move several fields at once.
+         * @param l the new layout
+         * @param oldDomains the local domains of all ranks before the layout changed
+         */
+        void redistribute(Layout_t& l, const std::vector<Domain_t>& oldDomains);
+
         /*!
          * Local field size.
          * @param d the dimension
@@ -203,6 +215,16 @@ namespace ippl {
         T min(int nghost = 0) const;
         T prod(int nghost = 0) const;
 
+        /*!
+         * Reduces several expressions over the owned domain of this field in one
+         * kernel and one collective (see Utility/BatchedReduction.h). The
+         * expressions may refer to other fields with the same layout.
+         * @param terms the expressions and their operations, e.g. sumOf(f * f)
+         * @returns the global results in the order of the terms
+         */
+        template <typename... Terms>
+        auto reduce(const Terms&... terms) const;
+
     private:
         //! Number of ghost layers on each field boundary
         int nghost_m;
@@ -224,6 +246,14 @@ namespace ippl {
         Layout_t* layout_m = nullptr;
     };
 
+    /*!
+     * Moves the owned values of several fields to a new layout. The local domains
+     * of the old layout are gathered once for all fields.
+     * @param layout the new layout (already updated, e.g. by the ORB)
+     * @param fields the fields, all still allocated for the same old layout
+     */
+    template <unsigned Dim, class... Fields>
+    void redistribute(FieldLayout<Dim>& layout, Fields&... fields);
 }  // namespace ippl
 
 #include "Field/BareField.hpp"
@@ -8,6 +8,7 @@
 #include <cstdlib>
 #include <limits>
 #include <map>
+#include <tuple>
 #include <utility>
 
 #include "Communicate/DataTypes.h"
@@ -119,6 +120,129 @@ namespace ippl {
         setup();
     }
 
+    template <typename T, unsigned Dim, class... ViewArgs>
+    void BareField<T, Dim, ViewArgs...>::redistribute(Layout_t& l,
+                                                      const std::vector<Domain_t>& oldDomains) {
+        using memory_space = typename view_type::memory_space;
+        using buffer_type  = mpi::Communicator::buffer_type<memory_space>;
+        using bound_type   = typename Layout_t::bound_type;
+
+        // Bounds of a part of the owned domain in view indices
+        auto bounds = [&](const Domain_t& part, const Domain_t& owned) {
+            bound_type range;
+            for (unsigned d = 0; d < Dim; d++) {
+                range.lo[d] = part[d].first() - owned[d].first() + nghost_m;
+                range.hi[d] = part[d].last() - owned[d].first() + nghost_m + 1;
+            }
+            return range;
+        };
+
+        const view_type oldView = dview_m;
+        const Domain_t oldOwned = owned_m;
+
+        // Allocate a new view rather than resizing, which would copy by index
+        dview_m = view_type();
+        updateLayout(l, nghost_m);
+
+        auto& comm             = l.comm;
+        const int myRank       = comm.rank();
+        const auto& newDomains = l.getHostLocalDomains();
+        const int tag          = mpi::tag::FIELD_REDISTRIBUTE;
+        typename halo_type::databuffer_type data;
+
+        // Send the parts of the old local domain that other ranks own now
+        std::vector<MPI_Request> requests;
+        std::vector<int> ranks;
+        l.getDomainTree().findTouching(oldOwned, ranks);
+        int sends = 0;
+        for (int rank : ranks) {
+            if (rank == myRank) {
+                continue;
+            }
+            detail::size_type nsends;
+            halo_m.pack(bounds(oldOwned.intersect(newDomains(rank)), oldOwned), oldView, data,
+                        nsends);
+
+            buffer_type buf = comm.template getBuffer<memory_space, T>(
+                mpi::tag::REDISTRIBUTE_SEND + sends++, nsends);
+
+            requests.resize(requests.size() + 1);
+            comm.isend(rank, tag, data, *buf, requests.back(), nsends);
+            buf->resetWritePos();
+        }
+
+        // The part this rank keeps is copied locally
+        using assign = typename halo_type::assign;
+        if (oldOwned.touches(owned_m)) {
+            const Domain_t overlap = oldOwned.intersect(owned_m);
+            detail::size_type ncopies;
+            halo_m.pack(bounds(overlap, oldOwned), oldView, data, ncopies);
+            halo_m.template unpack<assign>(bounds(overlap, owned_m), dview_m, data);
+        }
+
+        // Receive the parts of the new local domain that other ranks owned
+        detail::DomainTree<Dim> oldTree;
+        oldTree.build(oldDomains.data(), oldDomains.size());
+        ranks.clear();
+        oldTree.findTouching(owned_m, ranks);
+        int recvs = 0;
+        for (int rank : ranks) {
+            if (rank == myRank) {
+                continue;
+            }
+            const Domain_t overlap   = oldDomains[rank].intersect(owned_m);
+            detail::size_type nrecvs = overlap.size();
+
+            buffer_type buf = comm.template getBuffer<memory_space, T>(
+                mpi::tag::REDISTRIBUTE_RECV + recvs++, nrecvs);
+
+            comm.recv(rank, tag, data, *buf, nrecvs * sizeof(T), nrecvs);
+            buf->resetReadPos();
+
+            halo_m.template unpack<assign>(bounds(overlap, owned_m), dview_m, data);
+        }
+
+        if (requests.size() > 0) {
+            MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        }
+    }
+
+    template <unsigned Dim, class... Fields>
+    void redistribute(FieldLayout<Dim>& layout, Fields&... fields) {
+        using domain_type = NDIndex<Dim>;
+
+        // All fields are still allocated for the old layout
+        const domain_type owned = std::get<0>(std::tie(fields...)).getOwned();
+        auto isOwned = [&](const auto& field) {
+            for (unsigned d = 0; d < Dim; d++) {
+                if (!(field.getOwned()[d] == owned[d])) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        PAssert((isOwned(fields) && ...));
+
+        auto& comm = layout.comm;
+        std::vector<int> local(2 * Dim), all(2 * Dim * comm.size());
+        for (unsigned d = 0; d < Dim; d++) {
+            local[2 * d]     = owned[d].first();
+            local[2 * d + 1] = owned[d].last();
+        }
+        MPI_Allgather(local.data(), 2 * Dim, MPI_INT, all.data(), 2 * Dim, MPI_INT,
+                      comm.getCommunicator());
+
+        std::vector<domain_type> oldDomains(comm.size());
+        for (int rank = 0; rank < comm.size(); ++rank) {
+            for (unsigned d = 0; d < Dim; d++) {
+                const int* bounds   = all.data() + 2 * (rank * Dim + d);
+                oldDomains[rank][d] = Index(bounds[0], bounds[1]);
+            }
+        }
+
+        (fields.redistribute(layout, oldDomains), ...);
+    }
+
     template <typename T, unsigned Dim, class... ViewArgs>
     void BareField<T, Dim, ViewArgs...>::setup() {
         owned_m = layout_m->getLocalNDIndex();
@@ -215,4 +339,10 @@ namespace ippl {
     DefineReduction(Min, min, using Kokkos::min; valL = min(valL, myVal), std::less)
     DefineReduction(Prod, prod, valL *= myVal, std::multiplies)
 
+    template <typename T, unsigned Dim, class... ViewArgs>
+    template <typename... Terms>
+    auto BareField<T, Dim, ViewArgs...>::reduce(const Terms&... terms) const {
+        return detail::batchedReduce(layout_m->comm, getFieldRangePolicy(), terms...);
+    }
+
 }  // namespace ippl
@@ -3,6 +3,7 @@
 //   The guard / ghost cells of BareField.
 //
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -38,47 +39,80 @@ namespace ippl {
             const range_list &sendRanges   = layout->getNeighborsSendRange(),
                              &recvRanges   = layout->getNeighborsRecvRange();
 
-            size_t totalRequests = 0;
-            for (const auto& componentNeighbors : neighbors) {
-                totalRequests += componentNeighbors.size();
-            }
-
             using memory_space = typename view_type::memory_space;
             using buffer_type  = mpi::Communicator::buffer_type<memory_space>;
-            std::vector<MPI_Request> requests(totalRequests);
+            using data_view    = typename databuffer_type::view_type;
+            std::vector<MPI_Request> requests;
+
+            /*We store only the sending and receiving ranges
+             * of INTERNAL_TO_HALO and use the fact that the
+             * sending range of HALO_TO_INTERNAL is the receiving
+             * range of INTERNAL_TO_HALO and vice versa
+             */
+            auto sendRange = [&](size_t index, size_t i) {
+                return order == INTERNAL_TO_HALO ? sendRanges[index][i] : recvRanges[index][i];
+            };
+            auto recvRange = [&](size_t index, size_t i) {
+                return order == INTERNAL_TO_HALO ? recvRanges[index][i] : sendRanges[index][i];
+            };
 
-            // sending loop
             constexpr size_t cubeCount = detail::countHypercubes(Dim) - 1;
-            size_t requestIndex        = 0;
+
+            // Neighbors on the same node exchange through shared memory, which
+            // is only possible if the packing kernels can access host memory
+            using exec_space            = typename view_type::execution_space;
+            mpi::SharedMailbox* mailbox = nullptr;
+            if constexpr (Kokkos::SpaceAccessibility<exec_space, Kokkos::HostSpace>::accessible) {
+                mailbox = comm.getSharedMailbox();
+            }
+            if (mailbox) {
+                size_type nMessages = 0, nBytes = 0;
+                for (size_t index = 0; index < cubeCount; index++) {
+                    for (size_t i = 0; i < neighbors[index].size(); i++) {
+                        if (mailbox->isLocal(neighbors[index][i])) {
+                            ++nMessages;
+                            nBytes += mailbox->paddedSize(sendRange(index, i).size() * sizeof(T));
+                        }
+                    }
+                }
+                mailbox->begin(nMessages, nBytes);
+            }
+
+            // sending loop
             for (size_t index = 0; index < cubeCount; index++) {
                 int tag                        = mpi::tag::HALO + index;
                 const auto& componentNeighbors = neighbors[index];
                 for (size_t i = 0; i < componentNeighbors.size(); i++) {
                     int targetRank = componentNeighbors[i];
 
-                    bound_type range;
-                    if (order == INTERNAL_TO_HALO) {
-                        /*We store only the sending and receiving ranges
-                         * of INTERNAL_TO_HALO and use the fact that the
-                         * sending range of HALO_TO_INTERNAL is the receiving
-                         * range of INTERNAL_TO_HALO and vice versa
-                         */
-                        range = sendRanges[index][i];
-                    } else {
-                        range = recvRanges[index][i];
-                    }
+                    bound_type range = sendRange(index, i);
 
                     size_type nsends;
+                    if (mailbox && mailbox->isLocal(targetRank)) {
+                        // Pack straight into the shared segment
+                        nsends  = range.size();
+                        T* data = reinterpret_cast<T*>(
+                            mailbox->post(targetRank, tag, nsends * sizeof(T)));
+                        databuffer_type shared{data_view(data, nsends)};
+                        pack(range, view, shared, nsends);
+                        continue;
+                    }
+
                     pack(range, view, haloData_m, nsends);
 
                     buffer_type buf = comm.template getBuffer<memory_space, T>(
                         mpi::tag::HALO_SEND + i * cubeCount + index, nsends);
 
-                    comm.isend(targetRank, tag, haloData_m, *buf, requests[requestIndex++], nsends);
+                    requests.resize(requests.size() + 1);
+                    comm.isend(targetRank, tag, haloData_m, *buf, requests.back(), nsends);
                     buf->resetWritePos();
                 }
             }
 
+            if (mailbox) {
+                mailbox->publish();
+            }
+
             // receiving loop
             for (size_t index = 0; index < cubeCount; index++) {
                 int tag                        = mpi::tag::HALO + Layout_t::getMatchingIndex(index);
@@ -86,15 +120,19 @@ namespace ippl {
                 for (size_t i = 0; i < componentNeighbors.size(); i++) {
                     int sourceRank = componentNeighbors[i];
 
-                    bound_type range;
-                    if (order == INTERNAL_TO_HALO) {
-                        range = recvRanges[index][i];
-                    } else {
-                        range = sendRanges[index][i];
-                    }
+                    bound_type range = recvRange(index, i);
 
                     size_type nrecvs = range.size();
 
+                    if (mailbox && mailbox->isLocal(sourceRank)) {
+                        // Unpack straight from the sender's segment
+                        T* data = reinterpret_cast<T*>(
+                            mailbox->find(sourceRank, tag, nrecvs * sizeof(T)));
+                        databuffer_type shared{data_view(data, nrecvs)};
+                        unpack<Op>(range, view, shared);
+                        continue;
+                    }
+
                     buffer_type buf = comm.template getBuffer<memory_space, T>(
                         mpi::tag::HALO_RECV + i * cubeCount + index, nrecvs);
 
@@ -105,8 +143,8 @@ namespace ippl {
                 }
             }
 
-            if (totalRequests > 0) {
-                MPI_Waitall(totalRequests, requests.data(), MPI_STATUSES_IGNORE);
+            if (requests.size() > 0) {
+                MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
             }
         }
 
@@ -120,8 +158,8 @@ namespace ippl {
             size_t size = subview.size();
             nsends      = size;
             if (buffer.size() < size) {
-                int overalloc = Comm->getDefaultOverallocation();
-                Kokkos::realloc(buffer, size * overalloc);
+                double overalloc = std::max(1.0, Comm->getDefaultOverallocation());
+                Kokkos::realloc(buffer, size_type(size * overalloc));
             }
 
             using index_array_type =
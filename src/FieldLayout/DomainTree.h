@@ -0,0 +1,99 @@
+//
+// Class DomainTree
+//   Bounding box hierarchy over the local domains of a field layout.
+//
+//   Finding the ranks whose domains touch a given box by testing every rank
+//   costs O(P) per query. The tree answers the same query in O(log P + k) for
+//   k touching domains. The leaves are the domains in rank order and every
+//   inner node splits its range of ranks in half, storing the bounding box of
+//   its subtree. Both the ORB and the bisection of the Partitioner assign
+//   contiguous ranges of ranks to spatially compact parts of the domain, so
+//   the bounding boxes of the tree coincide with (or closely follow) their
+//   cuts. The tree is built in O(P) without sorting.
+//
+#ifndef IPPL_DOMAIN_TREE_H
+#define IPPL_DOMAIN_TREE_H
+
+#include <algorithm>
+#include <vector>
+
+#include "Index/NDIndex.h"
+
+namespace ippl {
+    namespace detail {
+
+        template <unsigned Dim>
+        class DomainTree {
+        public:
+            using NDIndex_t = NDIndex<Dim>;
+
+            /*!
+             * Rebuilds the tree for new domains
+             * @param domains the domain of each rank
+             * @param n the number of domains
+             */
+            void build(const NDIndex_t* domains, size_t n) {
+                nLeaves_m = n;
+                boxes_m.resize(n > 0 ? 2 * n - 1 : 0);
+                if (n > 0) {
+                    build(domains, 0, 0, n);
+                }
+            }
+
+            /*!
+             * Appends the ranks whose domains touch the box
+             * @param box the box to query
+             * @param ranks the list to which the ranks are appended
+             */
+            void findTouching(const NDIndex_t& box, std::vector<int>& ranks) const {
+                if (nLeaves_m > 0) {
+                    findTouching(box, ranks, 0, 0, nLeaves_m);
+                }
+            }
+
+        private:
+            /*
+             * The nodes are stored in pre-order. The subtree of a node covering n
+             * ranks occupies 2n - 1 consecutive entries, so its left child follows
+             * it directly and its right child follows the left subtree.
+             */
+            void build(const NDIndex_t* domains, size_t node, size_t lo, size_t hi) {
+                if (hi - lo == 1) {
+                    boxes_m[node] = domains[lo];
+                    return;
+                }
+                const size_t mid   = lo + (hi - lo) / 2;
+                const size_t left  = node + 1;
+                const size_t right = node + 2 * (mid - lo);
+                build(domains, left, lo, mid);
+                build(domains, right, mid, hi);
+
+                for (unsigned d = 0; d < Dim; ++d) {
+                    const Index& l = boxes_m[left][d];
+                    const Index& r = boxes_m[right][d];
+                    boxes_m[node][d] =
+                        Index(std::min(l.first(), r.first()), std::max(l.last(), r.last()));
+                }
+            }
+
+            void findTouching(const NDIndex_t& box, std::vector<int>& ranks, size_t node,
+                              size_t lo, size_t hi) const {
+                if (!box.touches(boxes_m[node])) {
+                    return;
+                }
+                if (hi - lo == 1) {
+                    ranks.push_back(lo);
+                    return;
+                }
+                const size_t mid = lo + (hi - lo) / 2;
+                findTouching(box, ranks, node + 1, lo, mid);
+                findTouching(box, ranks, node + 2 * (mid - lo), mid, hi);
+            }
+
+            size_t nLeaves_m = 0;
+            std::vector<NDIndex_t> boxes_m;
+        };
+    }  // namespace detail
+}  // namespace ippl
+
+#endif
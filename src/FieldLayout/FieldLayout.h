@@ -16,6 +16,7 @@
 #include "Types/ViewTypes.h"
 
 #include "Communicate/Communicator.h"
+#include "FieldLayout/DomainTree.h"
 #include "Index/NDIndex.h"
 #include "Partition/Partitioner.h"
 
@@ -200,8 +201,21 @@ namespace ippl {
          */
         FieldLayout(const mpi::Communicator& = MPI_COMM_WORLD);
 
+        /*!
+         * @param domain the global domain
+         * @param decomp which axes may be split among the ranks
+         * @param isAllPeriodic whether all boundaries are periodic
+         * @param strategy how the domain is split (see Partitioner.h)
+         * @param nghost the number of ghost layers the partition is optimized for
+         * @param capacities the relative speed of each rank, which receives a share of
+         * the cells proportional to it (default: all ranks equally fast)
+         * @param nodeAware whether the domain is first divided among the nodes and then
+         * among the ranks of each node, so that the ranks of a node own adjacent subdomains
+         */
         FieldLayout(mpi::Communicator, const NDIndex<Dim>& domain, std::array<bool, Dim> decomp,
-                    bool isAllPeriodic = false);
+                    bool isAllPeriodic = false,
+                    PartitionStrategy strategy = PartitionStrategy::BISECTION, int nghost = 1,
+                    const std::vector<double>& capacities = {}, bool nodeAware = false);
 
         // Destructor: Everything deletes itself automatically ... the base
         // class destructors inform all the FieldLayoutUser's we're going away.
@@ -213,7 +227,9 @@ namespace ippl {
         // FieldLayout constructors:
 
         void initialize(const NDIndex<Dim>& domain, std::array<bool, Dim> decomp,
-                        bool isAllPeriodic = false);
+                        bool isAllPeriodic = false,
+                        PartitionStrategy strategy = PartitionStrategy::BISECTION, int nghost = 1,
+                        const std::vector<double>& capacities = {}, bool nodeAware = false);
 
         // Return the domain.
         const NDIndex<Dim>& getDomain() const { return gDomain_m; }
@@ -251,6 +267,13 @@ namespace ippl {
 
         const view_type getDeviceLocalDomains() const;
 
+        /*!
+         * Get the bounding box hierarchy over the local domains, which finds
+         * the ranks whose domains touch a box in O(log P + k)
+         * @return The domain tree
+         */
+        const detail::DomainTree<Dim>& getDomainTree() const;
+
         /*!
          * Get a list of all the neighbors, arranged by ternary encoding
          * of the hypercubes
@@ -365,6 +388,9 @@ namespace ippl {
 
         unsigned int minWidth_m[Dim];
 
+        //! Bounding box hierarchy over the local domains
+        detail::DomainTree<Dim> domainTree_m;
+
         neighbor_list neighbors_m;
         neighbor_range_list neighborsSendRange_m, neighborsRecvRange_m;
 
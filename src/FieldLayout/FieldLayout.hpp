@@ -7,6 +7,7 @@
 //
 #include "Ippl.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <limits>
 
@@ -45,9 +46,11 @@ namespace ippl {
 
     template <unsigned Dim>
     FieldLayout<Dim>::FieldLayout(mpi::Communicator communicator, const NDIndex<Dim>& domain,
-                                  std::array<bool, Dim> isParallel, bool isAllPeriodic)
+                                  std::array<bool, Dim> isParallel, bool isAllPeriodic,
+                                  PartitionStrategy strategy, int nghost,
+                                  const std::vector<double>& capacities, bool nodeAware)
         : FieldLayout(communicator) {
-        initialize(domain, isParallel, isAllPeriodic);
+        initialize(domain, isParallel, isAllPeriodic, strategy, nghost, capacities, nodeAware);
     }
 
     template <unsigned Dim>
@@ -69,7 +72,9 @@ namespace ippl {
 
     template <unsigned Dim>
     void FieldLayout<Dim>::initialize(const NDIndex<Dim>& domain, std::array<bool, Dim> isParallel,
-                                      bool isAllPeriodic) {
+                                      bool isAllPeriodic, PartitionStrategy strategy,
+                                      int nghost, const std::vector<double>& capacities,
+                                      bool nodeAware) {
         int nRanks = comm.size();
 
         gDomain_m = domain;
@@ -83,6 +88,7 @@ namespace ippl {
             Kokkos::resize(hLocalDomains_m, nRanks);
             hLocalDomains_m(0) = domain;
             Kokkos::deep_copy(dLocalDomains_m, hLocalDomains_m);
+            domainTree_m.build(hLocalDomains_m.data(), hLocalDomains_m.extent(0));
             return;
         }
 
@@ -103,7 +109,13 @@ namespace ippl {
         Kokkos::resize(hLocalDomains_m, nRanks);
 
         detail::Partitioner<Dim> partitioner;
-        partitioner.split(domain, hLocalDomains_m, isParallel, nRanks);
+        if (nodeAware) {
+            partitioner.splitHierarchical(domain, hLocalDomains_m, isParallel, nRanks,
+                                          comm.nodeIds(), strategy, nghost, capacities);
+        } else {
+            partitioner.split(domain, hLocalDomains_m, isParallel, nRanks, strategy, nghost,
+                              capacities);
+        }
 
         findNeighbors();
 
@@ -128,6 +140,11 @@ namespace ippl {
         return dLocalDomains_m;
     }
 
+    template <unsigned Dim>
+    const detail::DomainTree<Dim>& FieldLayout<Dim>::getDomainTree() const {
+        return domainTree_m;
+    }
+
     template <unsigned Dim>
     const typename FieldLayout<Dim>::neighbor_list& FieldLayout<Dim>::getNeighbors() const {
         return neighbors_m;
@@ -235,11 +252,45 @@ namespace ippl {
         // grow the box by nghost cells in each dimension
         auto gnd = nd.grow(nghost);
 
+        static IpplTimings::TimerRef findCandidatesTimer = IpplTimings::getTimer("findCandidates");
         static IpplTimings::TimerRef findInternalNeighborsTimer =
             IpplTimings::getTimer("findInternal");
         static IpplTimings::TimerRef findPeriodicNeighborsTimer =
             IpplTimings::getTimer("findPeriodic");
-        for (int rank = 0; rank < comm.size(); ++rank) {
+
+        /* Only the ranks whose domains touch the grown box or one of its
+         * periodic images can be neighbors. The domain tree finds them
+         * without testing every rank.
+         */
+        IpplTimings::startTimer(findCandidatesTimer);
+        domainTree_m.build(hLocalDomains_m.data(), hLocalDomains_m.extent(0));
+
+        std::vector<int> candidates;
+        domainTree_m.findTouching(gnd, candidates);
+        if (isAllPeriodic_m) {
+            // Each digit of the base-3 image index selects no shift (0), the
+            // shift across the upper boundary (1) or across the lower boundary (2)
+            for (unsigned image = 1; image < detail::countHypercubes(Dim); ++image) {
+                NDIndex_t shifted = gnd;
+                bool exists       = true;
+                for (unsigned d = 0, digits = image; d < Dim && exists; ++d, digits /= 3) {
+                    if (digits % 3 == 0) {
+                        continue;
+                    }
+                    int offset = getPeriodicOffset(nd, d, digits % 3 - 1);
+                    exists     = offset != 0;
+                    shifted[d] += offset;
+                }
+                if (exists) {
+                    domainTree_m.findTouching(shifted, candidates);
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        IpplTimings::stopTimer(findCandidatesTimer);
+
+        for (int rank : candidates) {
             if (rank == myRank) {
                 // do not compare with my domain
                 continue;
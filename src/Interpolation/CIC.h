@@ -1,8 +1,8 @@
 //
 // Class CIC
-//   First order/cloud-in-cell grid interpolation. Currently implemented as
-//   global functions, but in order to support higher or lower order interpolation,
-//   these should be moved into structs.
+//   First order/cloud-in-cell grid interpolation implemented as global functions.
+//   Particle interpolation of arbitrary order goes through the shape functions in
+//   ShapeFunction.h; these functions are kept for existing callers.
 //
 #ifndef CIC_INTERPOLATION_H
 #define CIC_INTERPOLATION_H
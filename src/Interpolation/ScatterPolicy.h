@@ -0,0 +1,59 @@
+//
+// Scatter policies
+//   Tags selecting how particle data is deposited onto a field. The default
+//   uses one atomic addition per stencil point; the alternatives trade
+//   memory or a particle sort for fewer contended atomics.
+//
+#ifndef IPPL_SCATTER_POLICY_H
+#define IPPL_SCATTER_POLICY_H
+
+#include <any>
+#include <cstddef>
+#include <memory>
+
+namespace ippl {
+    namespace detail {
+        //! The duplicated field of a DuplicatedScatter, stored without its type
+        struct ScatterViewCache {
+            //! the Kokkos::Experimental::ScatterView
+            std::any scatterView;
+            //! the data and the span of the field view it was created for
+            const void* data = nullptr;
+            std::size_t span = 0;
+        };
+    }  // namespace detail
+
+    /*!
+     * Every particle adds its contribution to the field with atomics.
+     */
+    struct AtomicScatter {};
+
+    /*!
+     * The deposition goes through a Kokkos::Experimental::ScatterView, which picks
+     * per execution space between thread-private copies of the field that are
+     * summed afterwards (host backends with many threads) and atomics (GPUs).
+     * Duplication costs one field copy per thread. The copies are kept by the policy
+     * object and its copies, and reused as long as the field keeps its allocation,
+     * so a policy object that lives across time steps allocates them only once.
+     */
+    struct DuplicatedScatter {
+        std::shared_ptr<detail::ScatterViewCache> cache =
+            std::make_shared<detail::ScatterViewCache>();
+    };
+
+    /*!
+     * Each team deposits a contiguous chunk of particles into a tile held in team
+     * scratch memory and then flushes the tile to the field, so that there is at most
+     * one global atomic per tile point. The particles should be sorted by cell
+     * (see ParticleBase::sort), otherwise the tiles cover most of the domain and the
+     * deposition falls back to global atomics.
+     */
+    struct TiledScatter {
+        //! number of particles handled by one team
+        std::size_t particlesPerTeam = 512;
+        //! largest tile (in grid points) that is deposited in scratch memory
+        std::size_t maxTileSize = 4096;
+    };
+}  // namespace ippl
+
+#endif
@@ -0,0 +1,135 @@
+//
+// Class ShapeFunction
+//   B-spline particle shape functions of compile-time order for grid
+//   interpolation: nearest grid point (NGP), cloud-in-cell (CIC),
+//   triangular-shaped cloud (TSC) and piecewise quadratic spline (PQS).
+//   The stencil width is a compile-time constant, so the loops over the
+//   stencil points have fixed bounds.
+//
+#ifndef IPPL_SHAPE_FUNCTION_H
+#define IPPL_SHAPE_FUNCTION_H
+
+#include <Kokkos_Array.hpp>
+
+#include "Types/Vector.h"
+
+namespace ippl {
+    /*!
+     * @class ShapeFunction
+     * @tparam Order the order of the B-spline (0 to 3)
+     */
+    template <unsigned Order>
+    struct ShapeFunction {
+        static_assert(Order <= 3, "Shape functions are implemented up to third order");
+
+        //! the order of the shape function
+        static constexpr unsigned order = Order;
+
+        //! the number of grid points per dimension to which a particle contributes
+        static constexpr unsigned width = Order + 1;
+
+        //! the number of ghost layers needed around the local domain
+        static constexpr int ghostCells = (Order + 1) / 2;
+
+        /*!
+         * Computes the first grid point of the stencil along one axis
+         * @param x the position in cell units, cell i spanning [i, i + 1)
+         * @return The index of the first grid point to which the particle contributes
+         */
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION static int first(T x);
+
+        /*!
+         * Computes the weights of the stencil along one axis
+         * @param x the position in cell units, cell i spanning [i, i + 1)
+         * @param w the weights of the points first(x), ..., first(x) + width - 1
+         * @return The index of the first grid point to which the particle contributes
+         */
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION static int weights(T x, Kokkos::Array<T, width>& w);
+    };
+
+    using NGP = ShapeFunction<0>;
+    using CIC = ShapeFunction<1>;
+    using TSC = ShapeFunction<2>;
+    using PQS = ShapeFunction<3>;
+
+    namespace detail {
+        /*!
+         * The interpolation stencil of a single particle in Dim dimensions
+         * @tparam Shape the shape function
+         * @tparam T the weight type
+         * @tparam Dim the number of dimensions
+         */
+        template <typename Shape, typename T, unsigned Dim>
+        struct Stencil {
+            static constexpr unsigned width = Shape::width;
+
+            //! the number of grid points the particle contributes to
+            static constexpr unsigned long size = [] {
+                unsigned long n = 1;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    n *= width;
+                }
+                return n;
+            }();
+
+            /*!
+             * Computes the stencil of a particle
+             * @param x the particle position in cell units
+             * @param shift the offset from global cell indices to view indices
+             */
+            KOKKOS_INLINE_FUNCTION Stencil(const Vector<T, Dim>& x, const Vector<int, Dim>& shift);
+
+            /*!
+             * Calls a functor for every point of the stencil
+             * @param f callable taking the view indices of the point and its weight
+             */
+            template <typename Functor>
+            KOKKOS_INLINE_FUNCTION void forEach(const Functor& f) const;
+
+            //! the view index of the first point along each axis
+            Vector<int, Dim> first;
+
+            //! the weights along each axis
+            Kokkos::Array<Kokkos::Array<T, width>, Dim> weights;
+
+        private:
+            /*!
+             * Loops over the stencil points along one axis and recurses into the
+             * lower axes, so that the first axis runs fastest. Each loop has the
+             * compile-time bound width, and there is one instantiation per axis.
+             * @param point the view indices fixed by the higher axes
+             * @param weight the product of the weights of the higher axes
+             * @param f callable taking the view indices of the point and its weight
+             */
+            template <unsigned Axis, typename Functor>
+            KOKKOS_INLINE_FUNCTION void visit(Vector<size_t, Dim>& point, T weight,
+                                              const Functor& f) const;
+        };
+
+        /*!
+         * Scatters a value to a field view with atomics
+         * @param st the particle stencil
+         * @param view the field view
+         * @param val the value to scatter
+         */
+        template <typename Shape, typename T, unsigned Dim, typename View, typename V>
+        KOKKOS_INLINE_FUNCTION void scatterToField(const Stencil<Shape, T, Dim>& st,
+                                                   const View& view, const V& val);
+
+        /*!
+         * Gathers a value from a field view
+         * @param st the particle stencil
+         * @param view the field view
+         * @return The interpolated value
+         */
+        template <typename Shape, typename T, unsigned Dim, typename View>
+        KOKKOS_INLINE_FUNCTION typename View::value_type gatherFromField(
+            const Stencil<Shape, T, Dim>& st, const View& view);
+    }  // namespace detail
+}  // namespace ippl
+
+#include "Interpolation/ShapeFunction.hpp"
+
+#endif
@@ -0,0 +1,99 @@
+//
+// Class ShapeFunction
+//   B-spline particle shape functions of compile-time order for grid
+//   interpolation: nearest grid point (NGP), cloud-in-cell (CIC),
+//   triangular-shaped cloud (TSC) and piecewise quadratic spline (PQS).
+//   The stencil width is a compile-time constant, so the loops over the
+//   stencil points have fixed bounds.
+//
+
+namespace ippl {
+    template <unsigned Order>
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION int ShapeFunction<Order>::first(T x) {
+        // Grid points sit at the cell centers. Even orders are centered on the
+        // nearest point, odd orders start at the nearest point to the left.
+        if constexpr (Order % 2 == 0) {
+            return static_cast<int>(Kokkos::floor(x)) - int(Order / 2);
+        } else {
+            return static_cast<int>(Kokkos::floor(x - T(0.5))) - int(Order / 2);
+        }
+    }
+
+    template <unsigned Order>
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION int ShapeFunction<Order>::weights(T x, Kokkos::Array<T, width>& w) {
+        const int i = first(x);
+        // Distance from the nearest (even orders) or left (odd orders) grid point
+        [[maybe_unused]] const T d = x - T(0.5) - (i + int(Order / 2));
+
+        if constexpr (Order == 0) {
+            w[0] = 1;
+        } else if constexpr (Order == 1) {
+            w[0] = 1 - d;
+            w[1] = d;
+        } else if constexpr (Order == 2) {
+            w[0] = T(0.5) * (T(0.5) - d) * (T(0.5) - d);
+            w[1] = T(0.75) - d * d;
+            w[2] = T(0.5) * (T(0.5) + d) * (T(0.5) + d);
+        } else {
+            const T d2 = d * d;
+            const T d3 = d2 * d;
+            w[0]       = (1 - d) * (1 - d) * (1 - d) / 6;
+            w[1]       = (4 - 6 * d2 + 3 * d3) / 6;
+            w[2]       = (1 + 3 * d + 3 * d2 - 3 * d3) / 6;
+            w[3]       = d3 / 6;
+        }
+        return i;
+    }
+
+    namespace detail {
+        template <typename Shape, typename T, unsigned Dim>
+        KOKKOS_INLINE_FUNCTION Stencil<Shape, T, Dim>::Stencil(const Vector<T, Dim>& x,
+                                                              const Vector<int, Dim>& shift) {
+            for (unsigned d = 0; d < Dim; ++d) {
+                first[d] = Shape::weights(x[d], weights[d]) + shift[d];
+            }
+        }
+
+        template <typename Shape, typename T, unsigned Dim>
+        template <unsigned Axis, typename Functor>
+        KOKKOS_INLINE_FUNCTION void Stencil<Shape, T, Dim>::visit(Vector<size_t, Dim>& point,
+                                                                 T weight, const Functor& f) const {
+            for (unsigned i = 0; i < width; ++i) {
+                point[Axis]   = first[Axis] + i;
+                const T wAxis = weight * weights[Axis][i];
+                if constexpr (Axis == 0) {
+                    f(point, wAxis);
+                } else {
+                    visit<Axis - 1>(point, wAxis, f);
+                }
+            }
+        }
+
+        template <typename Shape, typename T, unsigned Dim>
+        template <typename Functor>
+        KOKKOS_INLINE_FUNCTION void Stencil<Shape, T, Dim>::forEach(const Functor& f) const {
+            Vector<size_t, Dim> point;
+            visit<Dim - 1>(point, T(1), f);
+        }
+
+        template <typename Shape, typename T, unsigned Dim, typename View, typename V>
+        KOKKOS_INLINE_FUNCTION void scatterToField(const Stencil<Shape, T, Dim>& st,
+                                                   const View& view, const V& val) {
+            st.forEach([&](const Vector<size_t, Dim>& point, const T& weight) {
+                Kokkos::atomic_add(&apply(view, point), val * weight);
+            });
+        }
+
+        template <typename Shape, typename T, unsigned Dim, typename View>
+        KOKKOS_INLINE_FUNCTION typename View::value_type gatherFromField(
+            const Stencil<Shape, T, Dim>& st, const View& view) {
+            typename View::value_type result = 0;
+            st.forEach([&](const Vector<size_t, Dim>& point, const T& weight) {
+                result += weight * apply(view, point);
+            });
+            return result;
+        }
+    }  // namespace detail
+}  // namespace ippl
@@ -50,6 +50,18 @@ namespace ippl {
                     } else {
                         throw std::runtime_error("Invalid timer fence option");
                     }
+                } else if (detail::checkOption(argv[nargs], "--shared-memory", "")) {
+                    ++nargs;
+                    if (nargs >= argc) {
+                        throw std::runtime_error("Missing shared memory enable option!");
+                    }
+                    if (std::strcmp(argv[nargs], "on") == 0) {
+                        mpi::Communicator::enableSharedMemory = true;
+                    } else if (std::strcmp(argv[nargs], "off") == 0) {
+                        mpi::Communicator::enableSharedMemory = false;
+                    } else {
+                        throw std::runtime_error("Invalid shared memory option");
+                    }
                 } else if (detail::checkOption(argv[nargs], "--version", "-v")) {
                     IpplInfo::printVersion();
                     std::string options = IpplInfo::compileOptions();
@@ -99,6 +111,7 @@ namespace ippl {
 
     void finalize() {
         Comm->deleteAllBuffers();
+        mpi::Communicator::freeCustomOperations();
         Kokkos::finalize();
         // we must first delete the communicator and
         // afterwards the MPI environment
@@ -30,10 +30,15 @@
 
 #include "Types/Vector.h"
 
+#include "Particle/ParticleAttribList.h"
 #include "Particle/ParticleBase.h"
+#include "Particle/ParticlePusher.h"
 #include "Particle/ParticleSpatialLayout.h"
+#include "Particle/ParticleSpeciesGroup.h"
 
 // // IPPL Load balancing
+#include "Decomposition/CostModel.h"
 #include "Decomposition/OrthogonalRecursiveBisection.h"
+#include "Decomposition/SpaceFillingCurve.h"
 
 #endif
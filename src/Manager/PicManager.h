@@ -76,6 +76,36 @@
             loadbalancer_m = loadbalancer;
         }
 
+       /**
+        * @brief Set how often the particles are sorted by grid cell.
+        *
+        * @param interval The number of time steps between two sorts (0 disables sorting).
+        */
+        void setSortInterval(int interval) {
+            sortInterval_m = interval;
+        }
+
+        int getSortInterval() const {
+            return sortInterval_m;
+        }
+
+       /**
+        * @brief Sort the particles by grid cell if the given step is a sorting step.
+        *
+        * Sorting keeps the scatter and gather operations cache friendly once the
+        * particle order has been scrambled by updates and deletions.
+        *
+        * @param it The current time step.
+        * @param mesh The mesh of the fields.
+        * @param fl The field layout giving the local domain.
+        */
+        template <typename Mesh, typename FieldLayout>
+        void sortParticles(int it, const Mesh& mesh, const FieldLayout& fl) {
+            if (sortInterval_m > 0 && it % sortInterval_m == 0) {
+                pcontainer_m->sort(mesh, fl);
+            }
+        }
+
     protected:
         std::shared_ptr<fc> fcontainer_m;
 
@@ -85,6 +115,8 @@
 
         std::shared_ptr<ippl::FieldSolverBase<T, Dim>> fsolver_m;
 
+        int sortInterval_m = 0;
+
     };
 }  // namespace ippl
  
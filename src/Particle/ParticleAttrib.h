@@ -17,27 +17,39 @@
 #define IPPL_PARTICLE_ATTRIB_H
 
 #include "Expression/IpplExpressions.h"
+#include "Utility/BatchedReduction.h"
 
 #include "Interpolation/CIC.h"
+#include "Interpolation/ScatterPolicy.h"
+#include "Interpolation/ShapeFunction.h"
 #include "Particle/ParticleAttribBase.h"
+#include "Particle/ParticleAttribStorage.h"
 
 namespace ippl {
 
     // ParticleAttrib class definition
     template <typename T, class... Properties>
-    class ParticleAttrib : public detail::ParticleAttribBase<>::with_properties<Properties...>,
-                           public detail::Expression<
-                               ParticleAttrib<T, Properties...>,
-                               sizeof(typename detail::ViewType<T, 1, Properties...>::view_type)> {
+    class ParticleAttrib
+        : public detail::ParticleAttribBase<>::with_properties<Properties...>,
+          public detail::Expression<
+              ParticleAttrib<T, Properties...>,
+              sizeof(typename detail::AttribStorage<T, Properties...>::view_type)> {
     public:
         typedef T value_type;
         constexpr static unsigned dim = 1;
 
         using Base = typename detail::ParticleAttribBase<>::with_properties<Properties...>;
 
-        using hash_type = typename Base::hash_type;
+        using hash_type    = typename Base::hash_type;
+        using scratch_type = typename Base::scratch_type;
 
-        using view_type = typename detail::ViewType<T, 1, Properties...>::view_type;
+        //! The storage policy (see ParticleAttribStorage.h)
+        using storage_type = detail::AttribStorage<T, Properties...>;
+
+        using view_type = typename storage_type::view_type;
+
+        //! The type returned by element access; T& unless stored as a struct of arrays
+        using reference = typename storage_type::reference;
 
         using HostMirror = typename view_type::host_mirror_type;
 
@@ -46,10 +58,6 @@ namespace ippl {
 
         using size_type = detail::size_type;
 
-        // Create storage for M particle attributes.  The storage is uninitialized.
-        // New items are appended to the end of the array.
-        void create(size_type) override;
-
         /*!
          * Particle deletion function. Partition the particles into a valid region
          * and an invalid region.
@@ -60,17 +68,27 @@ namespace ippl {
         void destroy(const hash_type& deleteIndex, const hash_type& keepIndex,
                      size_type invalidCount) override;
 
-        void pack(const hash_type&) override;
-
-        void unpack(size_type) override;
+        /*!
+         * Serializes the selected particles directly into the archive
+         * @param ar the send buffer
+         * @param hash the indices of the particles to send
+         */
+        void pack(detail::Archive<memory_space>& ar, const hash_type& hash) override;
 
-        void serialize(detail::Archive<memory_space>& ar, size_type nsends) override {
-            ar.serialize(buf_m, nsends);
-        }
+        /*!
+         * Deserializes received particles directly behind the local particles
+         * @param ar the receive buffer
+         * @param nrecvs the number of particles received
+         */
+        void unpack(detail::Archive<memory_space>& ar, size_type nrecvs) override;
 
-        void deserialize(detail::Archive<memory_space>& ar, size_type nrecvs) override {
-            ar.deserialize(buf_m, nrecvs);
-        }
+        /*!
+         * Reorder the local particles such that particle i is moved from
+         * position permute(i) to position i
+         * @param permute the permutation of the local particles
+         * @param scratch scratch memory of at least packedSize(localNum) bytes
+         */
+        void applyPermutation(const hash_type& permute, const scratch_type& scratch) override;
 
         virtual ~ParticleAttrib() = default;
 
@@ -80,7 +98,7 @@ namespace ippl {
             return count * sizeof(value_type);
         }
 
-        void resize(size_type n) { Kokkos::resize(dview_m, n); }
+        void resize(size_type n) override { Kokkos::resize(dview_m, n); }
 
         void realloc(size_type n) { Kokkos::realloc(dview_m, n); }
 
@@ -88,11 +106,20 @@ namespace ippl {
             HostMirror hview = Kokkos::create_mirror_view(dview_m);
             Kokkos::deep_copy(hview, dview_m);
             for (size_type i = 0; i < *(this->localNum_mp); ++i) {
-                std::cout << hview(i) << std::endl;
+                if constexpr (storage_type::isSoA) {
+                    for (unsigned d = 0; d < T::dim; ++d) {
+                        std::cout << (d == 0 ? "( " : " , ") << hview(i, d);
+                    }
+                    std::cout << " )" << std::endl;
+                } else {
+                    std::cout << hview(i) << std::endl;
+                }
             }
         }
 
-        KOKKOS_INLINE_FUNCTION T& operator()(const size_t i) const { return dview_m(i); }
+        KOKKOS_INLINE_FUNCTION reference operator()(const size_t i) const {
+            return storage_type::get(dview_m, i);
+        }
 
         view_type& getView() { return dview_m; }
 
@@ -117,14 +144,31 @@ namespace ippl {
         // KOKKOS_INLINE_FUNCTION
         ParticleAttrib<T, Properties...>& operator=(detail::Expression<E, N> const& expr);
 
-        //     // scatter the data from this attribute onto the given Field, using
-        //     // the given Position attribute
-        template <typename Field, typename P2>
+        /*!
+         * Scatter the data from this attribute onto the given Field, using
+         * the given Position attribute
+         * @tparam Shape the particle shape function (NGP, CIC, TSC or PQS)
+         * @tparam ScatterPolicy selects the deposition backend (see ScatterPolicy.h)
+         * @param f the field to scatter onto
+         * @param pp the particle positions (with either storage policy)
+         * @param policy the deposition backend and its parameters
+         */
+        template <typename Shape = CIC, typename Field, typename P2,
+                  typename ScatterPolicy = AtomicScatter, class... PositionProperties>
         void scatter(Field& f,
-                     const ParticleAttrib<Vector<P2, Field::dim>, Properties...>& pp) const;
+                     const ParticleAttrib<Vector<P2, Field::dim>, PositionProperties...>& pp,
+                     ScatterPolicy policy = ScatterPolicy()) const;
 
-        template <typename Field, typename P2>
-        void gather(Field& f, const ParticleAttrib<Vector<P2, Field::dim>, Properties...>& pp);
+        /*!
+         * Gather the data from the given Field into this attribute, using
+         * the given Position attribute
+         * @tparam Shape the particle shape function (NGP, CIC, TSC or PQS)
+         * @param f the field to gather from
+         * @param pp the particle positions (with either storage policy)
+         */
+        template <typename Shape = CIC, typename Field, typename P2, class... PositionProperties>
+        void gather(Field& f,
+                    const ParticleAttrib<Vector<P2, Field::dim>, PositionProperties...>& pp);
 
         T sum();
         T max();
@@ -133,8 +177,62 @@ namespace ippl {
 
     private:
         view_type dview_m;
-        view_type buf_m;
     };
+
+    namespace detail {
+        /*!
+         * An expression to be assigned to the local particles of an attribute
+         * as part of a fused assignment (see fusedAssign)
+         * @tparam Storage the storage policy of the attribute
+         * @tparam ExecSpace the execution space of the attribute
+         * @tparam E the expression type
+         * @tparam N the size of the expression
+         */
+        template <class Storage, class ExecSpace, typename E, size_t N>
+        struct ParticleAssignment {
+            using execution_space = ExecSpace;
+
+            typename Storage::view_type view_m;
+            CapturedExpression<E, N> expr_m;
+            size_type count_m;
+
+            KOKKOS_INLINE_FUNCTION void operator()(const size_t i) const {
+                Storage::get(view_m, i) = expr_m(i);
+            }
+        };
+    }  // namespace detail
+
+    /*!
+     * Pairs an attribute with the expression to assign to it in fusedAssign
+     * @param attrib the attribute to assign to
+     * @param expr the expression
+     */
+    template <typename T, class... Properties, typename E, size_t N>
+    auto assignment(ParticleAttrib<T, Properties...>& attrib,
+                    const detail::Expression<E, N>& expr);
+
+    /*!
+     * Evaluates several attribute assignments in a single kernel, e.g.
+     *     fusedAssign(assignment(P, P - dt * q / m * E), assignment(R, R + dt * P));
+     * performs both updates in one pass over the particles. The assignments are
+     * evaluated in order for each particle, so an expression sees the values assigned
+     * by the preceding ones, just as with consecutive assignments. Attribute
+     * expressions only access the particle being evaluated, which makes this valid.
+     * @param assignments the assignments, all to attributes in the same execution space
+     */
+    template <typename Assignment, typename... Assignments>
+    void fusedAssign(const Assignment& first, const Assignments&... rest);
+
+    /*!
+     * Reduces several attribute expressions over the local particles in one kernel
+     * and over all ranks in one collective (see Utility/BatchedReduction.h)
+     * @tparam ExecSpace the execution space of the attributes
+     * @param count the number of local particles
+     * @param terms the expressions and their operations, e.g. sumOf(q), maxOf(dot(P, P))
+     * @returns the global results in the order of the terms
+     */
+    template <class ExecSpace = Kokkos::DefaultExecutionSpace, typename... Terms>
+    auto reduceParticles(detail::size_type count, const Terms&... terms);
 }  // namespace ippl
 
 #include "Particle/ParticleAttrib.hpp"
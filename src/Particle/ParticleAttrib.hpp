@@ -15,21 +15,15 @@
 //
 #include "Ippl.h"
 
+#include <Kokkos_ScatterView.hpp>
+
 #include "Communicate/DataTypes.h"
 
+#include "Utility/IpplException.h"
 #include "Utility/IpplTimings.h"
 
 namespace ippl {
 
-    template <typename T, class... Properties>
-    void ParticleAttrib<T, Properties...>::create(size_type n) {
-        size_type required = *(this->localNum_mp) + n;
-        if (this->size() < required) {
-            int overalloc = Comm->getDefaultOverallocation();
-            this->realloc(required * overalloc);
-        }
-    }
-
     template <typename T, class... Properties>
     void ParticleAttrib<T, Properties...>::destroy(const hash_type& deleteIndex,
                                                    const hash_type& keepIndex,
@@ -40,40 +34,46 @@ namespace ippl {
         Kokkos::parallel_for(
             "ParticleAttrib::destroy()", policy_type(0, invalidCount),
             KOKKOS_CLASS_LAMBDA(const size_t i) {
-                dview_m(deleteIndex(i)) = dview_m(keepIndex(i));
+                storage_type::copy(dview_m, deleteIndex(i), dview_m, keepIndex(i));
             });
     }
 
     template <typename T, class... Properties>
-    void ParticleAttrib<T, Properties...>::pack(const hash_type& hash) {
-        auto size = hash.extent(0);
-        if (buf_m.extent(0) < size) {
-            int overalloc = Comm->getDefaultOverallocation();
-            Kokkos::realloc(buf_m, size * overalloc);
-        }
-
-        using policy_type = Kokkos::RangePolicy<execution_space>;
-        Kokkos::parallel_for(
-            "ParticleAttrib::pack()", policy_type(0, size),
-            KOKKOS_CLASS_LAMBDA(const size_t i) { buf_m(i) = dview_m(hash(i)); });
-        Kokkos::fence();
+    void ParticleAttrib<T, Properties...>::pack(detail::Archive<memory_space>& ar,
+                                                const hash_type& hash) {
+        ar.pack(dview_m, hash);
     }
 
     template <typename T, class... Properties>
-    void ParticleAttrib<T, Properties...>::unpack(size_type nrecvs) {
-        auto size          = dview_m.extent(0);
+    void ParticleAttrib<T, Properties...>::unpack(detail::Archive<memory_space>& ar,
+                                                  size_type nrecvs) {
+        // The bunch normally reserves room for the received particles in all
+        // attributes at once before receiving
         size_type required = *(this->localNum_mp) + nrecvs;
-        if (size < required) {
-            int overalloc = Comm->getDefaultOverallocation();
-            this->resize(required * overalloc);
+        if (this->size() < required) {
+            this->resize(required);
         }
 
-        size_type count   = *(this->localNum_mp);
+        ar.unpack(dview_m, *(this->localNum_mp), nrecvs);
+    }
+
+    template <typename T, class... Properties>
+    void ParticleAttrib<T, Properties...>::applyPermutation(const hash_type& permute,
+                                                            const scratch_type& scratch) {
+        size_type count = *(this->localNum_mp);
+        PAssert(scratch.size() >= packedSize(count));
+
+        // The scratch memory is shared by all attributes of the bunch
+        view_type buffer(reinterpret_cast<typename view_type::pointer_type>(scratch.data()),
+                         count);
+
         using policy_type = Kokkos::RangePolicy<execution_space>;
         Kokkos::parallel_for(
-            "ParticleAttrib::unpack()", policy_type(0, nrecvs),
-            KOKKOS_CLASS_LAMBDA(const size_t i) { dview_m(count + i) = buf_m(i); });
-        Kokkos::fence();
+            "ParticleAttrib::applyPermutation()", policy_type(0, count),
+            KOKKOS_CLASS_LAMBDA(const size_t i) {
+                storage_type::copy(buffer, i, dview_m, permute(i));
+            });
+        Kokkos::deep_copy(storage_type::head(dview_m, count), buffer);
     }
 
     template <typename T, class... Properties>
@@ -82,7 +82,7 @@ namespace ippl {
         using policy_type = Kokkos::RangePolicy<execution_space>;
         Kokkos::parallel_for(
             "ParticleAttrib::operator=()", policy_type(0, *(this->localNum_mp)),
-            KOKKOS_CLASS_LAMBDA(const size_t i) { dview_m(i) = x; });
+            KOKKOS_CLASS_LAMBDA(const size_t i) { (*this)(i) = x; });
         return *this;
     }
 
@@ -91,22 +91,54 @@ namespace ippl {
     // KOKKOS_INLINE_FUNCTION
     ParticleAttrib<T, Properties...>& ParticleAttrib<T, Properties...>::operator=(
         detail::Expression<E, N> const& expr) {
+        fusedAssign(assignment(*this, expr));
+        return *this;
+    }
+
+    template <typename T, class... Properties, typename E, size_t N>
+    auto assignment(ParticleAttrib<T, Properties...>& attrib,
+                    const detail::Expression<E, N>& expr) {
+        using attrib_type = ParticleAttrib<T, Properties...>;
+        using assignment_type =
+            detail::ParticleAssignment<typename attrib_type::storage_type,
+                                       typename attrib_type::execution_space, E, N>;
         using capture_type = detail::CapturedExpression<E, N>;
-        capture_type expr_ = reinterpret_cast<const capture_type&>(expr);
+
+        return assignment_type{attrib.getView(), reinterpret_cast<const capture_type&>(expr),
+                               attrib.getParticleCount()};
+    }
+
+    template <typename Assignment, typename... Assignments>
+    void fusedAssign(const Assignment& first, const Assignments&... rest) {
+        using execution_space = typename Assignment::execution_space;
+        static_assert(
+            (std::is_same_v<typename Assignments::execution_space, execution_space> && ...),
+            "All attributes of a fused assignment must be in the same execution space");
+        PAssert(((rest.count_m == first.count_m) && ...));
 
         using policy_type = Kokkos::RangePolicy<execution_space>;
         Kokkos::parallel_for(
-            "ParticleAttrib::operator=()", policy_type(0, *(this->localNum_mp)),
-            KOKKOS_CLASS_LAMBDA(const size_t i) { dview_m(i) = expr_(i); });
-        return *this;
+            "ParticleAttrib::fusedAssign()", policy_type(0, first.count_m),
+            KOKKOS_LAMBDA(const size_t i) {
+                first(i);
+                (rest(i), ...);
+            });
     }
 
     template <typename T, class... Properties>
-    template <typename Field, class PT>
+    template <typename Shape, typename Field, class PT, typename ScatterPolicy,
+              class... PositionProperties>
     void ParticleAttrib<T, Properties...>::scatter(
-        Field& f, const ParticleAttrib<Vector<PT, Field::dim>, Properties...>& pp) const {
+        Field& f, const ParticleAttrib<Vector<PT, Field::dim>, PositionProperties...>& pp,
+        [[maybe_unused]] ScatterPolicy policy) const {
         constexpr unsigned Dim = Field::dim;
         using PositionType     = typename Field::Mesh_t::value_type;
+        using stencil_type     = detail::Stencil<Shape, PositionType, Dim>;
+
+        if (f.getNghost() < Shape::ghostCells) {
+            throw IpplException("ParticleAttrib::scatter",
+                                "Too few ghost layers for the shape function");
+        }
 
         static IpplTimings::TimerRef scatterTimer = IpplTimings::getTimer("scatter");
         IpplTimings::startTimer(scatterTimer);
@@ -127,23 +159,162 @@ namespace ippl {
         const NDIndex<Dim>& lDom       = layout.getLocalNDIndex();
         const int nghost               = f.getNghost();
 
-        using policy_type = Kokkos::RangePolicy<execution_space>;
-        Kokkos::parallel_for(
-            "ParticleAttrib::scatter", policy_type(0, *(this->localNum_mp)),
-            KOKKOS_CLASS_LAMBDA(const size_t idx) {
-                // find nearest grid point
-                vector_type l                        = (pp(idx) - origin) * invdx + 0.5;
-                Vector<int, Field::dim> index        = l;
-                Vector<PositionType, Field::dim> whi = l - index;
-                Vector<PositionType, Field::dim> wlo = 1.0 - whi;
-
-                Vector<size_t, Field::dim> args = index - lDom.first() + nghost;
-
-                // scatter
-                const value_type& val = dview_m(idx);
-                detail::scatterToField(std::make_index_sequence<1 << Field::dim>{}, view, wlo, whi,
-                                       args, val);
-            });
+        // offset from global cell indices to view indices
+        Vector<int, Dim> shift;
+        for (unsigned d = 0; d < Dim; ++d) {
+            shift[d] = nghost - lDom[d].first();
+        }
+
+        const size_type nParticles = *(this->localNum_mp);
+
+        if constexpr (std::is_same_v<ScatterPolicy, DuplicatedScatter>) {
+            using scatter_view_type =
+                Kokkos::Experimental::ScatterView<typename view_type::data_type,
+                                                  typename view_type::array_layout,
+                                                  typename view_type::execution_space>;
+            // Reuse the duplicated field of the last deposition into the same view
+            detail::ScatterViewCache& cache = *policy.cache;
+            auto* cached                    = std::any_cast<scatter_view_type>(&cache.scatterView);
+            if (cached == nullptr || cache.data != view.data() || cache.span != view.span()) {
+                cache.scatterView = scatter_view_type(view);
+                cache.data        = view.data();
+                cache.span        = view.span();
+                cached            = std::any_cast<scatter_view_type>(&cache.scatterView);
+            } else {
+                cached->reset_except(view);
+            }
+            scatter_view_type scatterView = *cached;
+
+            using policy_type = Kokkos::RangePolicy<execution_space>;
+            Kokkos::parallel_for(
+                "ParticleAttrib::scatter (duplicated)", policy_type(0, nParticles),
+                KOKKOS_CLASS_LAMBDA(const size_t idx) {
+                    const stencil_type st((pp(idx) - origin) * invdx, shift);
+                    const value_type val = (*this)(idx);
+
+                    // scatter into the thread's copy of the field
+                    auto access = scatterView.access();
+                    st.forEach([&](const Vector<size_t, Dim>& point, const PositionType& weight) {
+                        apply(access, point) += val * weight;
+                    });
+                });
+            Kokkos::Experimental::contribute(view, scatterView);
+        } else if constexpr (std::is_same_v<ScatterPolicy, TiledScatter>) {
+            using field_value_type = typename Field::value_type;
+            using team_policy      = Kokkos::TeamPolicy<execution_space>;
+            using member_type      = typename team_policy::member_type;
+            using scratch_view     = Kokkos::View<field_value_type*,
+                                              typename execution_space::scratch_memory_space,
+                                              Kokkos::MemoryUnmanaged>;
+
+            const size_t chunk   = policy.particlesPerTeam;
+            const size_t maxTile = policy.maxTileSize;
+            const int nTeams     = (nParticles + chunk - 1) / chunk;
+
+            Kokkos::parallel_for(
+                "ParticleAttrib::scatter (tiled)",
+                team_policy(nTeams, Kokkos::AUTO)
+                    .set_scratch_size(0, Kokkos::PerTeam(scratch_view::shmem_size(maxTile))),
+                KOKKOS_CLASS_LAMBDA(const member_type& team) {
+                    const size_t begin = team.league_rank() * chunk;
+                    const size_t end   = Kokkos::min(begin + chunk, size_t(nParticles));
+
+                    // Bounding box of the team's particles in cell units
+                    Vector<PositionType, Dim> xmin, xmax;
+                    Kokkos::parallel_reduce(
+                        Kokkos::TeamThreadRange(team, begin, end),
+                        [&](const size_t idx, Vector<PositionType, Dim>& m) {
+                            m = min(m, Vector<PositionType, Dim>((pp(idx) - origin) * invdx));
+                        },
+                        KokkosCorrection::Min<Vector<PositionType, Dim>>(xmin));
+                    Kokkos::parallel_reduce(
+                        Kokkos::TeamThreadRange(team, begin, end),
+                        [&](const size_t idx, Vector<PositionType, Dim>& m) {
+                            m = max(m, Vector<PositionType, Dim>((pp(idx) - origin) * invdx));
+                        },
+                        KokkosCorrection::Max<Vector<PositionType, Dim>>(xmax));
+
+                    // The tile covers the stencils of all particles in the box
+                    Vector<size_t, Dim> lo, extent, stride;
+                    size_t tileSize = 1;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        const int first = Shape::first(xmin[d]);
+                        const int last  = Shape::first(xmax[d]) + int(Shape::width) - 1;
+                        lo[d]           = first + shift[d];
+                        extent[d]       = last - first + 1;
+                        stride[d]       = tileSize;
+                        tileSize *= extent[d];
+                    }
+
+                    auto stencil = [&](const size_t idx, auto&& deposit) {
+                        const stencil_type st((pp(idx) - origin) * invdx, shift);
+                        const value_type val = (*this)(idx);
+                        st.forEach([&](const Vector<size_t, Dim>& point,
+                                       const PositionType& weight) {
+                            deposit(point, val * weight);
+                        });
+                    };
+
+                    if (tileSize > maxTile) {
+                        // The particles are too spread out to fit in a tile
+                        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, begin, end),
+                                             [&](const size_t idx) {
+                                                 stencil(idx, [&](const auto& point,
+                                                                  const value_type& val) {
+                                                     Kokkos::atomic_add(&apply(view, point), val);
+                                                 });
+                                             });
+                        return;
+                    }
+
+                    scratch_view tile(team.team_scratch(0), tileSize);
+                    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, tileSize),
+                                         [&](const size_t i) { tile(i) = 0; });
+                    team.team_barrier();
+
+                    // Scratch atomics only contend within the team
+                    Kokkos::parallel_for(
+                        Kokkos::TeamThreadRange(team, begin, end), [&](const size_t idx) {
+                            stencil(idx, [&](const auto& point, const value_type& val) {
+                                size_t i = 0;
+                                for (unsigned d = 0; d < Dim; ++d) {
+                                    i += (point[d] - lo[d]) * stride[d];
+                                }
+                                Kokkos::atomic_add(&tile(i), val);
+                            });
+                        });
+                    team.team_barrier();
+
+                    // Flush the tile with one global atomic per non-empty point
+                    Kokkos::parallel_for(
+                        Kokkos::TeamThreadRange(team, tileSize), [&](const size_t i) {
+                            if (tile(i) == field_value_type(0)) {
+                                return;
+                            }
+                            Vector<size_t, Dim> point;
+                            size_t rem = i;
+                            for (unsigned d = 0; d < Dim; ++d) {
+                                point[d] = lo[d] + rem % extent[d];
+                                rem /= extent[d];
+                            }
+                            Kokkos::atomic_add(&apply(view, point), tile(i));
+                        });
+                });
+        } else {
+            static_assert(std::is_same_v<ScatterPolicy, AtomicScatter>,
+                          "Unknown scatter policy");
+
+            using policy_type = Kokkos::RangePolicy<execution_space>;
+            Kokkos::parallel_for(
+                "ParticleAttrib::scatter", policy_type(0, nParticles),
+                KOKKOS_CLASS_LAMBDA(const size_t idx) {
+                    const stencil_type st((pp(idx) - origin) * invdx, shift);
+
+                    // scatter
+                    const value_type val = (*this)(idx);
+                    detail::scatterToField(st, view, val);
+                });
+        }
         IpplTimings::stopTimer(scatterTimer);
 
         static IpplTimings::TimerRef accumulateHaloTimer = IpplTimings::getTimer("accumulateHalo");
@@ -153,11 +324,17 @@ namespace ippl {
     }
 
     template <typename T, class... Properties>
-    template <typename Field, typename P2>
+    template <typename Shape, typename Field, typename P2, class... PositionProperties>
     void ParticleAttrib<T, Properties...>::gather(
-        Field& f, const ParticleAttrib<Vector<P2, Field::dim>, Properties...>& pp) {
+        Field& f, const ParticleAttrib<Vector<P2, Field::dim>, PositionProperties...>& pp) {
         constexpr unsigned Dim = Field::dim;
         using PositionType     = typename Field::Mesh_t::value_type;
+        using stencil_type     = detail::Stencil<Shape, PositionType, Dim>;
+
+        if (f.getNghost() < Shape::ghostCells) {
+            throw IpplException("ParticleAttrib::gather",
+                                "Too few ghost layers for the shape function");
+        }
 
         static IpplTimings::TimerRef fillHaloTimer = IpplTimings::getTimer("fillHalo");
         IpplTimings::startTimer(fillHaloTimer);
@@ -181,21 +358,20 @@ namespace ippl {
         const NDIndex<Dim>& lDom       = layout.getLocalNDIndex();
         const int nghost               = f.getNghost();
 
+        // offset from global cell indices to view indices
+        Vector<int, Dim> shift;
+        for (unsigned d = 0; d < Dim; ++d) {
+            shift[d] = nghost - lDom[d].first();
+        }
+
         using policy_type = Kokkos::RangePolicy<execution_space>;
         Kokkos::parallel_for(
             "ParticleAttrib::gather", policy_type(0, *(this->localNum_mp)),
             KOKKOS_CLASS_LAMBDA(const size_t idx) {
-                // find nearest grid point
-                vector_type l                        = (pp(idx) - origin) * invdx + 0.5;
-                Vector<int, Field::dim> index        = l;
-                Vector<PositionType, Field::dim> whi = l - index;
-                Vector<PositionType, Field::dim> wlo = 1.0 - whi;
-
-                Vector<size_t, Field::dim> args = index - lDom.first() + nghost;
+                const stencil_type st((pp(idx) - origin) * invdx, shift);
 
                 // gather
-                dview_m(idx) = detail::gatherFromField(std::make_index_sequence<1 << Field::dim>{},
-                                                       view, wlo, whi, args);
+                (*this)(idx) = detail::gatherFromField(st, view);
             });
         IpplTimings::stopTimer(gatherTimer);
     }
@@ -205,14 +381,21 @@ namespace ippl {
      *
      */
 
-    template <typename Attrib1, typename Field, typename Attrib2>
-    inline void scatter(const Attrib1& attrib, Field& f, const Attrib2& pp) {
-        attrib.scatter(f, pp);
+    template <typename Shape = CIC, typename Attrib1, typename Field, typename Attrib2,
+              typename ScatterPolicy = AtomicScatter>
+    inline void scatter(const Attrib1& attrib, Field& f, const Attrib2& pp,
+                        ScatterPolicy policy = ScatterPolicy()) {
+        attrib.template scatter<Shape>(f, pp, policy);
     }
 
-    template <typename Attrib1, typename Field, typename Attrib2>
+    template <typename Shape = CIC, typename Attrib1, typename Field, typename Attrib2>
     inline void gather(Attrib1& attrib, Field& f, const Attrib2& pp) {
-        attrib.gather(f, pp);
+        attrib.template gather<Shape>(f, pp);
+    }
+
+    template <class ExecSpace, typename... Terms>
+    auto reduceParticles(detail::size_type count, const Terms&... terms) {
+        return detail::batchedReduce(*Comm, Kokkos::RangePolicy<ExecSpace>(0, count), terms...);
     }
 
 #define DefineParticleReduction(fun, name, op, MPI_Op)            \
@@ -223,7 +406,7 @@ namespace ippl {
         Kokkos::parallel_reduce(                                  \
             "fun", policy_type(0, *(this->localNum_mp)),          \
             KOKKOS_CLASS_LAMBDA(const size_t i, T& valL) {        \
-                T myVal = dview_m(i);                             \
+                T myVal = (*this)(i);                             \
                 op;                                               \
             },                                                    \
             Kokkos::fun<T>(temp));                                \
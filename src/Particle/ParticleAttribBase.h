@@ -18,6 +18,7 @@
 #include "Types/ViewTypes.h"
 
 #include "Communicate/Archive.h"
+#include "Particle/ParticleAttribStorage.h"
 
 namespace ippl {
     namespace detail {
@@ -29,32 +30,36 @@ namespace ippl {
                 using type         = ParticleAttribBase<memory_space>;
             };
 
+            // The storage policy is not a view property
+            template <class... Properties>
+            struct WithMemSpace<SoA, Properties...> : WithMemSpace<Properties...> {};
+
         public:
             using hash_type       = ippl::detail::hash_type<MemorySpace>;
+            using scratch_type    = ippl::detail::scratch_type<MemorySpace>;
             using memory_space    = MemorySpace;
             using execution_space = typename memory_space::execution_space;
 
             template <typename... Properties>
             using with_properties = typename WithMemSpace<Properties...>::type;
 
-            virtual void create(size_type) = 0;
+            //! Sets the capacity, preserving the stored particles
+            virtual void resize(size_type) = 0;
 
             virtual void destroy(const hash_type&, const hash_type&, size_type) = 0;
             virtual size_type packedSize(const size_type) const                 = 0;
 
-            virtual void pack(const hash_type&) = 0;
-
-            virtual void unpack(size_type) = 0;
+            virtual void pack(Archive<memory_space>& ar, const hash_type& hash) = 0;
 
-            virtual void serialize(Archive<memory_space>& ar, size_type nsends) = 0;
+            virtual void unpack(Archive<memory_space>& ar, size_type nrecvs) = 0;
 
-            virtual void deserialize(Archive<memory_space>& ar, size_type nrecvs) = 0;
+            virtual void applyPermutation(const hash_type&, const scratch_type&) = 0;
 
             virtual size_type size() const = 0;
 
             virtual ~ParticleAttribBase() = default;
 
-            void setParticleCount(size_type& num) { localNum_mp = &num; }
+            virtual void setParticleCount(size_type& num) { localNum_mp = &num; }
             size_type getParticleCount() const { return *localNum_mp; }
 
         protected:
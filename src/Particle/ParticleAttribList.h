@@ -0,0 +1,108 @@
+//
+// Class ParticleAttribList
+//   A compile-time list of particle attributes registered with a bunch as one.
+//
+//   ParticleBase visits its attributes through virtual calls, and each
+//   attribute launches its own kernels to destroy, pack and unpack particles.
+//   A ParticleAttribList knows the types of its attributes at compile time, so
+//   it moves the elements of all its attributes in a single kernel and the
+//   packed size of a particle is a constant. The buffer layout is the same as
+//   when the attributes are packed one by one.
+//
+//   The attributes of the list must live in the same memory space. They are
+//   not added to the bunch themselves; the list is added instead:
+//
+//     class UserParticles : public ParticleBase<PLayout> {
+//     public:
+//       ParticleAttrib<double> q;
+//       particle_position_type P, E;
+//       ParticleAttribList<ParticleAttrib<double>, particle_position_type,
+//                          particle_position_type> fused{q, P, E};
+//
+//       UserParticles(PLayout& L) : ParticleBase(L) { addAttribute(fused); }
+//     };
+//
+#ifndef IPPL_PARTICLE_ATTRIB_LIST_H
+#define IPPL_PARTICLE_ATTRIB_LIST_H
+
+#include <tuple>
+#include <type_traits>
+
+#include "Particle/ParticleAttribBase.h"
+
+namespace ippl {
+
+    /*!
+     * @class ParticleAttribList
+     * @tparam Attributes the attribute types (ParticleAttrib instances)
+     */
+    template <typename... Attributes>
+    class ParticleAttribList
+        : public std::tuple_element_t<0, std::tuple<Attributes...>>::Base {
+    public:
+        using Base = typename std::tuple_element_t<0, std::tuple<Attributes...>>::Base;
+
+        static_assert((std::is_same_v<typename Attributes::Base, Base> && ...),
+                      "All attributes of a list must be in the same memory space");
+
+        using hash_type       = typename Base::hash_type;
+        using scratch_type    = typename Base::scratch_type;
+        using memory_space    = typename Base::memory_space;
+        using execution_space = typename Base::execution_space;
+        using size_type       = detail::size_type;
+
+        //! The number of bytes a particle occupies in a send buffer
+        constexpr static size_type elementSize =
+            (sizeof(typename Attributes::value_type) + ...);
+
+        ParticleAttribList(Attributes&... attributes)
+            : attributes_m(&attributes...) {}
+
+        /*!
+         * Partitions all attributes into a valid and an invalid region in one kernel
+         * @param deleteIndex List of indices of invalid particles in the valid region
+         * @param keepIndex List of indices of valid particles in the invalid region
+         * @param invalidCount Number of invalid particles in the valid region
+         */
+        void destroy(const hash_type& deleteIndex, const hash_type& keepIndex,
+                     size_type invalidCount) override;
+
+        /*!
+         * Serializes the selected particles of all attributes in one kernel
+         * @param ar the send buffer
+         * @param hash the indices of the particles to send
+         */
+        void pack(detail::Archive<memory_space>& ar, const hash_type& hash) override;
+
+        /*!
+         * Deserializes received particles of all attributes in one kernel
+         * @param ar the receive buffer
+         * @param nrecvs the number of particles received
+         */
+        void unpack(detail::Archive<memory_space>& ar, size_type nrecvs) override;
+
+        void applyPermutation(const hash_type& permute, const scratch_type& scratch) override;
+
+        //! @returns the smallest capacity of the attributes
+        size_type size() const override;
+
+        size_type packedSize(const size_type count) const override { return count * elementSize; }
+
+        void resize(size_type n) override;
+
+        void setParticleCount(size_type& num) override;
+
+        virtual ~ParticleAttribList() = default;
+
+    private:
+        template <typename... Views>
+        static void destroyViews(const hash_type& deleteIndex, const hash_type& keepIndex,
+                                 size_type invalidCount, const Views&... views);
+
+        std::tuple<Attributes*...> attributes_m;
+    };
+}  // namespace ippl
+
+#include "Particle/ParticleAttribList.hpp"
+
+#endif
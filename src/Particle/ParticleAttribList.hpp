@@ -0,0 +1,83 @@
+//
+// Class ParticleAttribList
+//   A compile-time list of particle attributes registered with a bunch as one.
+//
+#include <algorithm>
+
+namespace ippl {
+
+    template <typename... Attributes>
+    template <typename... Views>
+    void ParticleAttribList<Attributes...>::destroyViews(const hash_type& deleteIndex,
+                                                         const hash_type& keepIndex,
+                                                         size_type invalidCount,
+                                                         const Views&... views) {
+        using policy_type = Kokkos::RangePolicy<execution_space>;
+        Kokkos::parallel_for(
+            "ParticleAttribList::destroy()", policy_type(0, invalidCount),
+            KOKKOS_LAMBDA(const size_t i) {
+                (Attributes::storage_type::copy(views, deleteIndex(i), views, keepIndex(i)), ...);
+            });
+    }
+
+    template <typename... Attributes>
+    void ParticleAttribList<Attributes...>::destroy(const hash_type& deleteIndex,
+                                                    const hash_type& keepIndex,
+                                                    size_type invalidCount) {
+        std::apply(
+            [&](auto*... attributes) {
+                destroyViews(deleteIndex, keepIndex, invalidCount, attributes->getView()...);
+            },
+            attributes_m);
+    }
+
+    template <typename... Attributes>
+    void ParticleAttribList<Attributes...>::pack(detail::Archive<memory_space>& ar,
+                                                 const hash_type& hash) {
+        std::apply([&](auto*... attributes) { ar.packAll(hash, attributes->getView()...); },
+                   attributes_m);
+    }
+
+    template <typename... Attributes>
+    void ParticleAttribList<Attributes...>::unpack(detail::Archive<memory_space>& ar,
+                                                   size_type nrecvs) {
+        size_type count    = *(this->localNum_mp);
+        size_type required = count + nrecvs;
+        if (size() < required) {
+            resize(required);
+        }
+
+        std::apply(
+            [&](auto*... attributes) { ar.unpackAll(count, nrecvs, attributes->getView()...); },
+            attributes_m);
+    }
+
+    template <typename... Attributes>
+    void ParticleAttribList<Attributes...>::applyPermutation(const hash_type& permute,
+                                                             const scratch_type& scratch) {
+        // The scratch memory is reused by one attribute after the other
+        std::apply(
+            [&](auto*... attributes) { (attributes->applyPermutation(permute, scratch), ...); },
+            attributes_m);
+    }
+
+    template <typename... Attributes>
+    typename ParticleAttribList<Attributes...>::size_type ParticleAttribList<Attributes...>::size()
+        const {
+        return std::apply(
+            [](const auto*... attributes) { return std::min({attributes->size()...}); },
+            attributes_m);
+    }
+
+    template <typename... Attributes>
+    void ParticleAttribList<Attributes...>::resize(size_type n) {
+        std::apply([&](auto*... attributes) { (attributes->resize(n), ...); }, attributes_m);
+    }
+
+    template <typename... Attributes>
+    void ParticleAttribList<Attributes...>::setParticleCount(size_type& num) {
+        Base::setParticleCount(num);
+        std::apply([&](auto*... attributes) { (attributes->setParticleCount(num), ...); },
+                   attributes_m);
+    }
+}  // namespace ippl
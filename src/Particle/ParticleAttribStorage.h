@@ -0,0 +1,199 @@
+//
+// Particle attribute storage
+//   Storage policies for particle attributes. By default an attribute is a
+//   one dimensional view of its value type, i.e. vector-valued attributes are
+//   stored as an array of structs (AoS). With the SoA policy, vector-valued
+//   attributes are stored as one contiguous array per component (a view of
+//   rank two with layout left), which lets the compiler vectorize kernels over
+//   the particles. In both cases attrib(i)[d] accesses component d of
+//   particle i.
+//
+#ifndef IPPL_PARTICLE_ATTRIB_STORAGE_H
+#define IPPL_PARTICLE_ATTRIB_STORAGE_H
+
+#include <Kokkos_Core.hpp>
+
+#include <type_traits>
+#include <utility>
+
+#include "Types/ViewTypes.h"
+
+#include "Expression/IpplExpressions.h"
+#include "Types/Vector.h"
+
+namespace ippl {
+    /*!
+     * Storage policy for vector-valued particle attributes storing each component
+     * in its own contiguous array. It is passed as the first property of the
+     * attribute, e.g. ParticleAttrib<Vector<double, 3>, SoA, ExecSpace>.
+     */
+    struct SoA {};
+
+    namespace detail {
+        /*!
+         * Reference to a vector-valued attribute element stored as a structure of
+         * arrays. It behaves like a Vector in expressions and assignments, while
+         * operator[] refers to the underlying storage. It converts to a Vector
+         * through the expression constructor of Vector.
+         * @tparam T the component type
+         * @tparam Dim the number of components
+         * @tparam View the rank two view type
+         */
+        template <typename T, unsigned Dim, class View>
+        class SoAVectorRef : public Expression<SoAVectorRef<T, Dim, View>,
+                                               sizeof(View) + sizeof(std::size_t)> {
+        public:
+            using value_type              = T;
+            constexpr static unsigned dim = Dim;
+
+            KOKKOS_INLINE_FUNCTION SoAVectorRef(const View& view, std::size_t i)
+                : view_m(view)
+                , i_m(i) {}
+
+            KOKKOS_DEFAULTED_FUNCTION SoAVectorRef(const SoAVectorRef&) = default;
+
+            KOKKOS_INLINE_FUNCTION T& operator[](std::size_t d) const { return view_m(i_m, d); }
+
+            KOKKOS_INLINE_FUNCTION T& operator()(std::size_t d) const { return view_m(i_m, d); }
+
+            /*!
+             * Copies the components of another element (not the reference itself)
+             */
+            KOKKOS_INLINE_FUNCTION const SoAVectorRef& operator=(const SoAVectorRef& other) const {
+                for (unsigned d = 0; d < Dim; ++d) {
+                    view_m(i_m, d) = other[d];
+                }
+                return *this;
+            }
+
+            template <typename E, std::size_t N>
+            KOKKOS_INLINE_FUNCTION const SoAVectorRef& operator=(
+                const Expression<E, N>& expr) const {
+                // Evaluate first in case the expression refers to this element
+                const Vector<T, Dim> v = expr;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    view_m(i_m, d) = v[d];
+                }
+                return *this;
+            }
+
+            KOKKOS_INLINE_FUNCTION const SoAVectorRef& operator=(const T& val) const {
+                for (unsigned d = 0; d < Dim; ++d) {
+                    view_m(i_m, d) = val;
+                }
+                return *this;
+            }
+
+            template <typename E, std::size_t N>
+            KOKKOS_INLINE_FUNCTION const SoAVectorRef& operator+=(
+                const Expression<E, N>& expr) const {
+                const Vector<T, Dim> v = expr;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    view_m(i_m, d) += v[d];
+                }
+                return *this;
+            }
+
+            template <typename E, std::size_t N>
+            KOKKOS_INLINE_FUNCTION const SoAVectorRef& operator-=(
+                const Expression<E, N>& expr) const {
+                const Vector<T, Dim> v = expr;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    view_m(i_m, d) -= v[d];
+                }
+                return *this;
+            }
+
+        private:
+            View view_m;
+            std::size_t i_m;
+        };
+
+        /*!
+         * Storage of a particle attribute (array of structs)
+         * @tparam T the attribute value type
+         * @tparam Properties the view properties
+         */
+        template <typename T, class... Properties>
+        struct AttribStorage {
+            using view_type = typename ViewType<T, 1, Properties...>::view_type;
+            using reference = T&;
+
+            constexpr static bool isSoA = false;
+
+            //! Element i of the attribute
+            KOKKOS_INLINE_FUNCTION static reference get(const view_type& view, std::size_t i) {
+                return view(i);
+            }
+
+            //! Copies element j of src to element i of dst
+            KOKKOS_INLINE_FUNCTION static void copy(const view_type& dst, std::size_t i,
+                                                    const view_type& src, std::size_t j) {
+                dst(i) = src(j);
+            }
+
+            //! The first n elements
+            static auto head(const view_type& view, std::size_t n) {
+                return Kokkos::subview(view, std::make_pair(std::size_t(0), n));
+            }
+        };
+
+        template <typename T, class... Properties>
+        struct AttribStorage<T, SoA, Properties...> {
+            static_assert(!std::is_same_v<T, T>,
+                          "The SoA storage policy is only available for vector attributes");
+        };
+
+        /*!
+         * Storage of a vector-valued particle attribute (struct of arrays)
+         * @tparam T the component type
+         * @tparam Dim the number of components
+         * @tparam Properties the view properties
+         */
+        template <typename T, unsigned Dim, class... Properties>
+        struct AttribStorage<Vector<T, Dim>, SoA, Properties...> {
+            using view_type = Kokkos::View<T* [Dim], Kokkos::LayoutLeft, Properties...>;
+            using reference = SoAVectorRef<T, Dim, view_type>;
+
+            constexpr static bool isSoA = true;
+
+            KOKKOS_INLINE_FUNCTION static reference get(const view_type& view, std::size_t i) {
+                return reference(view, i);
+            }
+
+            KOKKOS_INLINE_FUNCTION static void copy(const view_type& dst, std::size_t i,
+                                                    const view_type& src, std::size_t j) {
+                for (unsigned d = 0; d < Dim; ++d) {
+                    dst(i, d) = src(j, d);
+                }
+            }
+
+            static auto head(const view_type& view, std::size_t n) {
+                return Kokkos::subview(view, std::make_pair(std::size_t(0), n), Kokkos::ALL);
+            }
+        };
+
+        /*!
+         * Component d of element i of a vector-valued attribute view with either storage
+         * @param view the attribute view
+         * @param i the particle index
+         * @param d the component
+         */
+        template <class View>
+        KOKKOS_INLINE_FUNCTION decltype(auto) component(const View& view, std::size_t i,
+                                                        unsigned d) {
+            if constexpr (View::rank == 2) {
+                return view(i, d);
+            } else {
+                return view(i)[d];
+            }
+        }
+
+        //! The component type of a vector-valued attribute view with either storage
+        template <class View>
+        using component_type = std::remove_cv_t<std::remove_reference_t<decltype(component(
+            std::declval<const View&>(), std::size_t(0), 0u))>>;
+    }  // namespace detail
+}  // namespace ippl
+
+#endif
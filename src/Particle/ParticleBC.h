@@ -5,6 +5,12 @@
 #ifndef IPPL_PARTICLE_BC_H
 #define IPPL_PARTICLE_BC_H
 
+#include <Kokkos_Array.hpp>
+
+#include <array>
+
+#include "Types/Vector.h"
+
 #include "Region/NDRegion.h"
 
 namespace ippl {
@@ -17,121 +23,110 @@ namespace ippl {
 
     namespace detail {
 
-        template <typename T, unsigned Dim, class ViewType>
-        struct ParticleBC {
-            using value_type = typename ViewType::value_type::value_type;
-
-            //! Kokkos view containing the field data
-            ViewType view_m;
-            //! The dimension along which this boundary condition
-            //  is applied
-            size_t dim_m;
-            //! Minimum and maximum coordinates of the domain along the given dimension
-            double minval_m;
-            double maxval_m;
-            //! Whether the boundary conditions are being applied for an upper
-            //  face (i.e. with greater coordinate values)
-            bool isUpper_m;
-
-            //! The length of the domain along the given dimension
-            double extent_m;
-            //! The coordinate of the midpoint of the domain along the given dimension
-            double middle_m;
-
-            KOKKOS_DEFAULTED_FUNCTION
-            ParticleBC() = default;
-
-            KOKKOS_INLINE_FUNCTION ParticleBC(const ViewType& view, const NDRegion<T, Dim>& nr,
-                                              const unsigned& dim, const bool& isUpper)
-                : view_m(view)
-                , dim_m(dim)
-                , minval_m(nr[dim].min())
-                , maxval_m(nr[dim].max())
-                , isUpper_m(isUpper) {
-                extent_m = nr[dim].length();
-                middle_m = (minval_m + maxval_m) / 2;
-            }
-
-            KOKKOS_DEFAULTED_FUNCTION
-            ~ParticleBC() = default;
-        };
-
-        template <typename T, unsigned Dim, class ViewType>
-        struct PeriodicBC : public ParticleBC<T, Dim, ViewType> {
-            using value_type = typename ParticleBC<T, Dim, ViewType>::value_type;
-
-            using ParticleBC<T, Dim, ViewType>::extent_m;
-            using ParticleBC<T, Dim, ViewType>::middle_m;
-
-            KOKKOS_DEFAULTED_FUNCTION
-            PeriodicBC() = default;
-
-            KOKKOS_INLINE_FUNCTION PeriodicBC(const ViewType& view, const NDRegion<T, Dim>& nr,
-                                              const unsigned& dim, const bool& isUpper)
-                : ParticleBC<T, Dim, ViewType>(view, nr, dim, isUpper) {}
-
-            KOKKOS_INLINE_FUNCTION void operator()(const size_t& i) const {
-                value_type& value = this->view_m(i)[this->dim_m];
-                value             = value - extent_m * (int)((value - middle_m) * 2 / extent_m);
-            }
+        /*!
+         * Wraps a coordinate back into a periodic domain
+         * @param value the coordinate
+         * @param extent the length of the domain
+         * @param middle the midpoint of the domain
+         */
+        template <typename V>
+        KOKKOS_INLINE_FUNCTION void periodicBC(V& value, double extent, double middle) {
+            value = value - extent * (int)((value - middle) * 2 / extent);
+        }
+
+        /*!
+         * Mirrors a coordinate that left the domain through the given face
+         * @param value the coordinate
+         * @param minval lower bound of the domain
+         * @param maxval upper bound of the domain
+         * @param isUpper whether the face is the upper face
+         */
+        template <typename V>
+        KOKKOS_INLINE_FUNCTION void reflectiveBC(V& value, double minval, double maxval,
+                                                 bool isUpper) {
+            bool tooHigh = value >= maxval;
+            bool tooLow  = value < minval;
+            value += 2
+                     * ((tooHigh && isUpper) * (maxval - value)
+                        + (tooLow && !isUpper) * (minval - value));
+        }
+
+        /*!
+         * Moves a coordinate that left the domain through the given face onto the face
+         * @param value the coordinate
+         * @param minval lower bound of the domain
+         * @param maxval upper bound of the domain
+         * @param isUpper whether the face is the upper face
+         */
+        template <typename V>
+        KOKKOS_INLINE_FUNCTION void sinkBC(V& value, double minval, double maxval, bool isUpper) {
+            bool tooHigh = value >= maxval;
+            bool tooLow  = value < minval;
+            value += (tooHigh && isUpper) * (maxval - value)
+                     + (tooLow && !isUpper) * (minval - value);
+        }
+
+        /*!
+         * The boundary conditions of all faces applied to a single particle
+         * position. All faces are handled in the same pass, both when the layout
+         * applies the boundary conditions and in kernels that move the particles.
+         * The configuration is the same for all particles, so the branches on it
+         * do not diverge.
+         * @tparam T the coordinate type
+         * @tparam Dim the dimension
+         */
+        template <typename T, unsigned Dim>
+        struct PositionBC {
+            //! The boundary condition of each face, ordered as in ParticleLayout
+            Kokkos::Array<BC, 2 * Dim> bcs_m;
+            //! Bounds of the domain
+            Vector<double, Dim> min_m;
+            Vector<double, Dim> max_m;
 
             KOKKOS_DEFAULTED_FUNCTION
-            ~PeriodicBC() = default;
-        };
-
-        template <typename T, unsigned Dim, class ViewType>
-        struct ReflectiveBC : public ParticleBC<T, Dim, ViewType> {
-            using value_type = typename ParticleBC<T, Dim, ViewType>::value_type;
-
-            using ParticleBC<T, Dim, ViewType>::maxval_m;
-            using ParticleBC<T, Dim, ViewType>::minval_m;
-            using ParticleBC<T, Dim, ViewType>::isUpper_m;
-
-            KOKKOS_DEFAULTED_FUNCTION
-            ReflectiveBC() = default;
-
-            KOKKOS_INLINE_FUNCTION ReflectiveBC(const ViewType& view, const NDRegion<T, Dim>& nr,
-                                                const unsigned& dim, const bool& isUpper)
-                : ParticleBC<T, Dim, ViewType>(view, nr, dim, isUpper) {}
-
-            KOKKOS_INLINE_FUNCTION void operator()(const size_t& i) const {
-                value_type& value = this->view_m(i)[this->dim_m];
-                bool tooHigh      = value >= maxval_m;
-                bool tooLow       = value < minval_m;
-                value += 2
-                         * ((tooHigh && isUpper_m) * (maxval_m - value)
-                            + (tooLow && !isUpper_m) * (minval_m - value));
+            PositionBC() = default;
+
+            PositionBC(const std::array<BC, 2 * Dim>& bcs, const NDRegion<T, Dim>& nr) {
+                for (unsigned face = 0; face < 2 * Dim; ++face) {
+                    bcs_m[face] = bcs[face];
+                }
+                for (unsigned d = 0; d < Dim; ++d) {
+                    min_m[d] = nr[d].min();
+                    max_m[d] = nr[d].max();
+                }
             }
 
-            KOKKOS_DEFAULTED_FUNCTION
-            ~ReflectiveBC() = default;
-        };
-
-        template <typename T, unsigned Dim, class ViewType>
-        struct SinkBC : public ParticleBC<T, Dim, ViewType> {
-            using value_type = typename ParticleBC<T, Dim, ViewType>::value_type;
-
-            using ParticleBC<T, Dim, ViewType>::maxval_m;
-            using ParticleBC<T, Dim, ViewType>::minval_m;
-            using ParticleBC<T, Dim, ViewType>::isUpper_m;
-
-            KOKKOS_DEFAULTED_FUNCTION
-            SinkBC() = default;
-
-            KOKKOS_INLINE_FUNCTION SinkBC(const ViewType& view, const NDRegion<T, Dim>& nr,
-                                          const unsigned& dim, const bool& isUpper)
-                : ParticleBC<T, Dim, ViewType>(view, nr, dim, isUpper) {}
-
-            KOKKOS_INLINE_FUNCTION void operator()(const size_t& i) const {
-                value_type& value = this->view_m(i)[this->dim_m];
-                bool tooHigh      = value >= maxval_m;
-                bool tooLow       = value < minval_m;
-                value += (tooHigh && isUpper_m) * (maxval_m - value)
-                         + (tooLow && !isUpper_m) * (minval_m - value);
+            /*!
+             * Applies the boundary conditions of all faces
+             * @param x the position
+             * @returns whether the position reached a sink face
+             */
+            KOKKOS_INLINE_FUNCTION bool operator()(Vector<T, Dim>& x) const {
+                bool sunk = false;
+                for (unsigned face = 0; face < 2 * Dim; ++face) {
+                    unsigned d   = face / 2;
+                    bool isUpper = face & 1;
+                    switch (bcs_m[face]) {
+                        case BC::PERIODIC:
+                            // Both sides are handled by the lower face
+                            if (!isUpper) {
+                                periodicBC(x[d], max_m[d] - min_m[d], (min_m[d] + max_m[d]) / 2);
+                            }
+                            break;
+                        case BC::REFLECTIVE:
+                            reflectiveBC(x[d], min_m[d], max_m[d], isUpper);
+                            break;
+                        case BC::SINK:
+                            sunk |= isUpper ? x[d] >= max_m[d] : x[d] < min_m[d];
+                            sinkBC(x[d], min_m[d], max_m[d], isUpper);
+                            break;
+                        case BC::NO:
+                        default:
+                            break;
+                    }
+                }
+                return sunk;
             }
-
-            KOKKOS_DEFAULTED_FUNCTION
-            ~SinkBC() = default;
         };
 
     }  // namespace detail
@@ -57,12 +57,16 @@
 
 #include "Types/IpplTypes.h"
 
+#include "Utility/SpaceFillingCurveKeys.h"
 #include "Utility/TypeUtils.h"
 
 #include "Particle/ParticleLayout.h"
 
 namespace ippl {
 
+    template <class... Bunches>
+    class ParticleSpeciesGroup;
+
     /*!
      * @class ParticleBase
      * @tparam PLayout the particle layout implementing an algorithm to
@@ -75,6 +79,9 @@ namespace ippl {
     class ParticleBase {
         constexpr static bool EnableIDs = sizeof...(IDProperties) > 0;
 
+        template <class... Bunches>
+        friend class ParticleSpeciesGroup;
+
     public:
         using vector_type            = typename PLayout::vector_type;
         using index_type             = typename PLayout::index_type;
@@ -96,6 +103,9 @@ namespace ippl {
 
         using hash_container_type = typename detail::ContainerForAllSpaces<detail::hash_type>::type;
 
+        using scratch_container_type =
+            typename detail::ContainerForAllSpaces<detail::scratch_type>::type;
+
         using size_type = detail::size_type;
 
     public:
@@ -145,10 +155,57 @@ namespace ippl {
         void setLocalNum(size_type size) { localNum_m = size; }
 
         /*!
-         * @returns total number of particles (across all processes)
+         * @returns total number of particles (across all processes) as of the last
+         * collective creation, deletion or updateTotalNum(); see isTotalNumStale()
          */
         size_type getTotalNum() const { return totalNum_m; }
 
+        /*!
+         * @returns whether particles were created or absorbed locally on this rank
+         * since the total number was last computed
+         */
+        bool isTotalNumStale() const { return totalNumStale_m; }
+
+        /*!
+         * Recomputes the total number of particles. This is a collective call.
+         */
+        void updateTotalNum();
+
+        /*!
+         * Sets how the storage of the attributes and the scratch views of the bunch
+         * grow and shrink
+         * @param growthFactor when the capacity is exceeded, all attributes are
+         *        grown at once to the required size times this factor (at least 1)
+         * @param shrinkThreshold after particles are destroyed or sent away, the
+         *        attributes are shrunk if the local number of particles drops below
+         *        this fraction of the capacity; 0 never shrinks
+         */
+        void setCapacityPolicy(double growthFactor, double shrinkThreshold = 0);
+
+        /*!
+         * @returns the number of local particles that fit in all attributes
+         */
+        size_type getCapacity() const;
+
+        /*!
+         * Grows all attributes to hold at least the given number of local particles
+         * @param capacity the number of local particles
+         */
+        void reserve(size_type capacity);
+
+        /*!
+         * Makes room for the given number of local particles, growing all attributes
+         * by the growth factor if they are too small
+         * @param required the number of local particles
+         */
+        void growCapacity(size_type required);
+
+        /*!
+         * Shrinks all attributes to the local number of particles and releases the
+         * scratch views
+         */
+        void shrinkToFit();
+
         /*!
          * @returns particle layout
          */
@@ -172,7 +229,13 @@ namespace ippl {
         void setParticleBC(BC bc) { layout_m->setParticleBC(bc); }
 
         /*!
-         * Add particle attribute
+         * @returns the boundary conditions of all faces
+         */
+        const bc_container_type& getParticleBC() const { return layout_m->getParticleBC(); }
+
+        /*!
+         * Add particle attribute. A ParticleAttribList adds several attributes
+         * that are destroyed and communicated in fused kernels.
          * @param pa attribute to be added to ParticleBase
          */
         template <typename MemorySpace>
@@ -240,9 +303,36 @@ namespace ippl {
          */
         void create(size_type nLocal);
 
+        /*!
+         * Create nLocal particles on this rank only. This is not a collective call;
+         * the total number of particles is only recomputed by the next collective
+         * creation, deletion or updateTotalNum().
+         * @param nLocal number of local particles to be created
+         */
+        void createLocal(size_type nLocal);
+
+        /*!
+         * Create nLocal particles on this rank only, with the IDs firstID to
+         * firstID + nLocal - 1. This is not a collective call.
+         * @param nLocal number of local particles to be created
+         * @param firstID the ID of the first particle, e.g. from allocateIDs()
+         */
+        void createLocal(size_type nLocal, index_type firstID);
+
+        /*!
+         * Reserve n consecutive particle IDs on every rank with one exclusive scan
+         * over the ranks. The blocks are consecutive in rank order and disjoint from
+         * all IDs handed out before. This is a collective call. A rank may reserve
+         * IDs for several later calls to createLocal at once.
+         * @param n the number of IDs to reserve on this rank
+         * @returns the first reserved ID of this rank
+         */
+        index_type allocateIDs(size_type n);
+
         /*!
          * Create a new particle with a given ID. This is a collective call. If a process
-         * passes a negative number, it does not create a particle.
+         * passes a negative number, it does not create a particle. To create many
+         * particles with given IDs, use createLocal(nLocal, firstID) instead.
          * @param id particle identity number
          */
         void createWithID(index_type id);
@@ -264,8 +354,51 @@ namespace ippl {
         template <typename... Properties>
         void destroy(const Kokkos::View<bool*, Properties...>& invalid, const size_type destroyNum);
 
-        // This is a collective call.
-        void update() { layout_m->update(*this); }
+        /*!
+         * Delete particles on this rank only, e.g. those absorbed by a sink. This is
+         * not a collective call; the total number of particles is only recomputed by
+         * the next collective creation, deletion or updateTotalNum().
+         * @param invalid View marking which indices are invalid
+         * @param destroyNum Number of local invalid particles
+         */
+        template <typename... Properties>
+        void destroyLocal(const Kokkos::View<bool*, Properties...>& invalid,
+                          const size_type destroyNum);
+
+        /*!
+         * Redistribute the particles among the ranks. This is a collective call.
+         * @param applyBC whether the layout applies the boundary conditions first;
+         *        pass false after a push that already enforced them (see pushParticles)
+         */
+        void update(bool applyBC = true) {
+            layout_m->update(*this, applyBC);
+            releaseCapacity();
+        }
+
+        /*!
+         * Reorder the local particles by a key using a counting sort. All
+         * attributes are permuted such that particles with equal keys are
+         * contiguous and the keys are ascending. The order within a key is
+         * not preserved. This is a local call.
+         * @tparam KeyView the view type of the keys (determines where the sort runs)
+         * @param keys a key in [0, nKeys) for each local particle
+         * @param nKeys the number of distinct keys
+         */
+        template <typename KeyView>
+        void sort(const KeyView& keys, size_type nKeys);
+
+        /*!
+         * Reorder the local particles by the grid cell they are in, such that
+         * scatter and gather operations access the field in memory order.
+         * This is a local call.
+         * @tparam Mesh the mesh type
+         * @tparam FieldLayout the field layout type
+         * @param mesh the mesh of the field
+         * @param layout the field layout giving the local domain
+         * @param useMorton order the cells along a Morton curve instead of by linear index
+         */
+        template <typename Mesh, typename FieldLayout>
+        void sort(const Mesh& mesh, const FieldLayout& layout, bool useMorton = false);
 
         /*
          * The following functions should not be called in an application.
@@ -302,15 +435,37 @@ namespace ippl {
         void recvFromRank(int rank, int tag, int recvNum, size_type nRecvs);
 
         /*!
-         * Serialize to do MPI calls.
-         * @param ar archive
+         * Sends particles to a rank on the same node by packing them into the
+         * shared memory mailbox, one message per memory space
+         * @param rank the destination rank
+         * @param tag the tag of the first message
+         * @param mailbox the mailbox of the current exchange round
+         * @param hash a hash view indicating which particles need to be sent to which rank
          */
-        template <typename Archive>
-        void serialize(Archive& ar, size_type nsends);
+        template <typename HashType>
+        void sendToMailbox(int rank, int tag, mpi::SharedMailbox& mailbox, const HashType& hash);
 
         /*!
-         * Deserialize to do MPI calls.
+         * Receives particles from a rank on the same node by unpacking them from
+         * the rank's shared memory segment
+         * @param rank the source rank
+         * @param tag the tag of the first message
+         * @param mailbox the mailbox of the current exchange round
+         * @param nRecvs the number of particles to receive
+         */
+        void recvFromMailbox(int rank, int tag, mpi::SharedMailbox& mailbox, size_type nRecvs);
+
+        /*!
+         * @returns whether all attributes can be packed from host memory, so that
+         * particles can be exchanged through shared memory
+         */
+        bool isHostAccessible() const;
+
+        /*!
+         * Deserialize to do MPI calls. The received particles are written
+         * directly behind the local particles.
          * @param ar archive
+         * @param nrecvs the number of particles received
          */
         template <typename Archive>
         void deserialize(Archive& ar, size_type nrecvs);
@@ -326,19 +481,30 @@ namespace ippl {
 
     protected:
         /*!
-         * Fill attributes of buffer.
-         * @param buffer to send
-         * @param hash function to access index.
+         * Serialize the attributes of the selected particles into the send buffer.
+         * @param ar the send buffer
+         * @param hash the indices of the particles to send
          */
-        void pack(const hash_container_type& hash);
+        template <typename Archive, typename HashType>
+        void pack(Archive& ar, const HashType& hash);
 
+    private:
         /*!
-         * Fill my attributes.
-         * @param buffer received
+         * Create nLocal local particles with the IDs firstID + stride * i
          */
-        void unpack(size_type nrecvs);
+        void createParticles(size_type nLocal, index_type firstID, index_type stride);
+
+        /*!
+         * Shrinks the attributes if the capacity policy asks for it
+         */
+        void releaseCapacity();
+
+        /*!
+         * Reallocates a scratch view with the growth factor if it is too small
+         */
+        template <typename View>
+        void growScratch(View& view, size_type required);
 
-    private:
         //! particle layout
         // cannot use std::unique_ptr due to Kokkos
         Layout_t* layout_m;
@@ -349,6 +515,9 @@ namespace ippl {
         //! total number of particles (across all processes)
         size_type totalNum_m;
 
+        //! whether particles were created or absorbed locally since totalNum_m was computed
+        bool totalNumStale_m;
+
         //! all attributes
         attribute_container_type attributes_m;
 
@@ -361,6 +530,21 @@ namespace ippl {
         //! buffers for particle partitioning
         hash_container_type deleteIndex_m;
         hash_container_type keepIndex_m;
+
+        //! buffer for the permutation computed by sort
+        hash_container_type sortIndex_m;
+
+        //! buffer for the first position of each key in sort
+        hash_container_type sortOffsets_m;
+
+        //! scratch memory shared by all attributes when applying a permutation
+        scratch_container_type permuteScratch_m;
+
+        //! factor by which the attributes and scratch views are overallocated when grown
+        double growthFactor_m;
+
+        //! fraction of the capacity below which the attributes are shrunk (0 never shrinks)
+        double shrinkThreshold_m;
     };
 }  // namespace ippl
 
@@ -49,6 +49,11 @@
 //   attributes: a radius rad (double), and a velocity vel (a 3D Vector).
 //
 
+#include <algorithm>
+#include <limits>
+
+#include "Utility/IpplTimings.h"
+
 namespace ippl {
 
     template <class PLayout, typename... IP>
@@ -56,8 +61,11 @@ namespace ippl {
         : layout_m(nullptr)
         , localNum_m(0)
         , totalNum_m(0)
+        , totalNumStale_m(false)
         , nextID_m(Comm->rank())
-        , numNodes_m(Comm->size()) {
+        , numNodes_m(Comm->size())
+        , growthFactor_m(std::max(1.0, Comm->getDefaultOverallocation()))
+        , shrinkThreshold_m(0) {
         if constexpr (EnableIDs) {
             addAttribute(ID);
         }
@@ -87,49 +95,171 @@ namespace ippl {
 
     template <class PLayout, typename... IP>
     void ParticleBase<PLayout, IP...>::create(size_type nLocal) {
+        createLocal(nLocal);
+        updateTotalNum();
+    }
+
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::createLocal(size_type nLocal) {
+        createParticles(nLocal, nextID_m, numNodes_m);
+        nextID_m += numNodes_m * nLocal;
+    }
+
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::createLocal(size_type nLocal, index_type firstID) {
+        createParticles(nLocal, firstID, 1);
+    }
+
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::createParticles(size_type nLocal, index_type firstID,
+                                                       index_type stride) {
         PAssert(layout_m != nullptr);
 
-        if (nLocal > 0) {
-            forAllAttributes([&]<typename Attribute>(Attribute& attribute) {
-                attribute->create(nLocal);
-            });
+        if (nLocal == 0) {
+            return;
+        }
 
-            if constexpr (EnableIDs) {
-                // set the unique ID value for these new particles
-                using policy_type =
-                    Kokkos::RangePolicy<size_type, typename particle_index_type::execution_space>;
-                auto pIDs     = ID.getView();
-                auto nextID   = this->nextID_m;
-                auto numNodes = this->numNodes_m;
-                Kokkos::parallel_for(
-                    "ParticleBase<...>::create(size_t)", policy_type(localNum_m, nLocal),
-                    KOKKOS_LAMBDA(const std::int64_t i) { pIDs(i) = nextID + numNodes * i; });
-                // nextID_m += numNodes_m * (nLocal - localNum_m);
-                nextID_m += numNodes_m * nLocal;
-            }
+        growCapacity(localNum_m + nLocal);
 
-            // remember that we're creating these new particles
-            localNum_m += nLocal;
+        if constexpr (EnableIDs) {
+            // set the unique ID value for these new particles
+            using policy_type =
+                Kokkos::RangePolicy<size_type, typename particle_index_type::execution_space>;
+            auto pIDs           = ID.getView();
+            const size_type off = localNum_m;
+            Kokkos::parallel_for(
+                "ParticleBase<...>::create(size_t)", policy_type(off, off + nLocal),
+                KOKKOS_LAMBDA(const size_type i) {
+                    pIDs(i) = firstID + stride * index_type(i - off);
+                });
         }
 
+        // remember that we're creating these new particles
+        localNum_m += nLocal;
+        totalNumStale_m = true;
+    }
+
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::updateTotalNum() {
         Comm->allreduce(localNum_m, totalNum_m, 1, std::plus<size_type>());
+        totalNumStale_m = false;
     }
 
     template <class PLayout, typename... IP>
-    void ParticleBase<PLayout, IP...>::createWithID(index_type id) {
-        PAssert(layout_m != nullptr);
+    void ParticleBase<PLayout, IP...>::setCapacityPolicy(double growthFactor,
+                                                         double shrinkThreshold) {
+        PAssert(growthFactor >= 1);
+        PAssert(shrinkThreshold >= 0 && shrinkThreshold < 1);
+        growthFactor_m    = growthFactor;
+        shrinkThreshold_m = shrinkThreshold;
+    }
 
-        size_type n = (id > -1) ? 1 : 0;
+    template <class PLayout, typename... IP>
+    detail::size_type ParticleBase<PLayout, IP...>::getCapacity() const {
+        size_type capacity = std::numeric_limits<size_type>::max();
+        forAllAttributes([&]<typename Attributes>(const Attributes& atts) {
+            for (const auto& attribute : atts) {
+                capacity = std::min(capacity, attribute->size());
+            }
+        });
+        return capacity;
+    }
 
-        // temporary change
-        index_type tmpNextID = nextID_m;
-        nextID_m             = id;
-        numNodes_m           = 0;
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::reserve(size_type capacity) {
+        forAllAttributes([&]<typename Attribute>(Attribute& attribute) {
+            if (attribute->size() < capacity) {
+                attribute->resize(capacity);
+            }
+        });
+    }
 
-        create(n);
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::growCapacity(size_type required) {
+        if (getCapacity() < required) {
+            reserve(static_cast<size_type>(required * growthFactor_m));
+        }
+    }
+
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::shrinkToFit() {
+        forAllAttributes([&]<typename Attribute>(Attribute& attribute) {
+            if (attribute->size() > localNum_m) {
+                attribute->resize(localNum_m);
+            }
+        });
 
-        nextID_m   = tmpNextID;
-        numNodes_m = Comm->size();
+        auto release = [&]<typename View>(View& view) {
+            view = View();
+        };
+        deleteIndex_m.forAll(release);
+        keepIndex_m.forAll(release);
+        sortIndex_m.forAll(release);
+        sortOffsets_m.forAll(release);
+        permuteScratch_m.forAll(release);
+    }
+
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::releaseCapacity() {
+        if (shrinkThreshold_m == 0) {
+            return;
+        }
+
+        const size_type capacity = getCapacity();
+        if (localNum_m < shrinkThreshold_m * capacity) {
+            // Keep the headroom of the growth factor to avoid growing right away
+            const size_type target = static_cast<size_type>(localNum_m * growthFactor_m);
+            forAllAttributes([&]<typename Attribute>(Attribute& attribute) {
+                if (attribute->size() > target) {
+                    attribute->resize(target);
+                }
+            });
+        }
+    }
+
+    template <class PLayout, typename... IP>
+    template <typename View>
+    void ParticleBase<PLayout, IP...>::growScratch(View& view, size_type required) {
+        if (view.size() < required) {
+            Kokkos::realloc(view, static_cast<size_type>(required * growthFactor_m));
+        }
+    }
+
+    template <class PLayout, typename... IP>
+    typename ParticleBase<PLayout, IP...>::index_type ParticleBase<PLayout, IP...>::allocateIDs(
+        size_type n) {
+        const index_type count = n;
+        index_type offset      = 0;
+        Comm->exscan(count, offset, std::plus<index_type>());
+
+        // All IDs handed out so far are below the largest next ID of any rank
+        struct Range {
+            index_type base;
+            index_type total;
+        };
+        struct CombineRanges {
+            void operator()(Range& inout, const Range& in) const {
+                inout.base = std::max(inout.base, in.base);
+                inout.total += in.total;
+            }
+        };
+        Range range{nextID_m, count};
+        Comm->allreduceCustom(range, CombineRanges{});
+
+        const index_type base = range.base;
+
+        // Continue the interleaved IDs of createLocal(nLocal) after the reserved blocks
+        const index_type end  = base + range.total;
+        const index_type rank = Comm->rank();
+        nextID_m              = end + ((rank - end) % numNodes_m + numNodes_m) % numNodes_m;
+
+        return base + offset;
+    }
+
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::createWithID(index_type id) {
+        createLocal((id > -1) ? 1 : 0, id);
+        updateTotalNum();
     }
 
     template <class PLayout, typename... IP>
@@ -155,7 +285,18 @@ namespace ippl {
                                                const size_type destroyNum) {
         this->internalDestroy(invalid, destroyNum);
 
-        Comm->allreduce(localNum_m, totalNum_m, 1, std::plus<size_type>());
+        updateTotalNum();
+        releaseCapacity();
+    }
+
+    template <class PLayout, typename... IP>
+    template <typename... Properties>
+    void ParticleBase<PLayout, IP...>::destroyLocal(
+        const Kokkos::View<bool*, Properties...>& invalid, const size_type destroyNum) {
+        if (destroyNum > 0) {
+            this->internalDestroy(invalid, destroyNum);
+            totalNumStale_m = true;
+        }
     }
 
     template <class PLayout, typename... IP>
@@ -184,18 +325,9 @@ namespace ippl {
         auto& locDeleteIndex  = deleteIndex_m.get<memory_space>();
         auto& locKeepIndex    = keepIndex_m.get<memory_space>();
 
-        // Resize buffers, if necessary
-        detail::runForAllSpaces([&]<typename MemorySpace>() {
-            if (attributes_m.template get<memory_space>().size() > 0) {
-                int overalloc = Comm->getDefaultOverallocation();
-                auto& del     = deleteIndex_m.get<memory_space>();
-                auto& keep    = keepIndex_m.get<memory_space>();
-                if (del.size() < destroyNum) {
-                    Kokkos::realloc(del, destroyNum * overalloc);
-                    Kokkos::realloc(keep, destroyNum * overalloc);
-                }
-            }
-        });
+        // Resize buffers, if necessary; they are reused across calls
+        growScratch(locDeleteIndex, destroyNum);
+        growScratch(locKeepIndex, destroyNum);
 
         // Reset index buffer
         Kokkos::deep_copy(locDeleteIndex, -1);
@@ -262,6 +394,134 @@ namespace ippl {
         });
     }
 
+    template <class PLayout, typename... IP>
+    template <typename KeyView>
+    void ParticleBase<PLayout, IP...>::sort(const KeyView& keys, size_type nKeys) {
+        static IpplTimings::TimerRef sortTimer = IpplTimings::getTimer("sortParticles");
+
+        if (localNum_m < 2) {
+            return;
+        }
+
+        IpplTimings::startTimer(sortTimer);
+
+        using memory_space    = typename KeyView::memory_space;
+        using execution_space = typename KeyView::execution_space;
+        using policy_type     = Kokkos::RangePolicy<execution_space>;
+
+        auto& permute = sortIndex_m.get<memory_space>();
+        growScratch(permute, localNum_m);
+
+        // Count the particles per key; offsets(k + 1) holds the count of key k
+        auto& offsets = sortOffsets_m.get<memory_space>();
+        growScratch(offsets, nKeys + 1);
+        Kokkos::deep_copy(Kokkos::subview(offsets, Kokkos::make_pair(size_type(0), nKeys + 1)), 0);
+        Kokkos::parallel_for(
+            "Histogram in ParticleBase::sort()", policy_type(0, localNum_m),
+            KOKKOS_LAMBDA(const size_t i) { Kokkos::atomic_increment(&offsets(keys(i) + 1)); });
+
+        // After the scan, offsets(k) is the first position of key k
+        Kokkos::parallel_scan(
+            "Scan in ParticleBase::sort()", policy_type(0, nKeys + 1),
+            KOKKOS_LAMBDA(const size_t k, int& sum, const bool final) {
+                sum += offsets(k);
+                if (final) {
+                    offsets(k) = sum;
+                }
+            });
+
+        Kokkos::parallel_for(
+            "Permutation in ParticleBase::sort()", policy_type(0, localNum_m),
+            KOKKOS_LAMBDA(const size_t i) {
+                const int pos = Kokkos::atomic_fetch_add(&offsets(keys(i)), 1);
+                permute(pos)  = i;
+            });
+        Kokkos::fence();
+
+        auto filter = [&]<typename MemorySpace>() {
+            return attributes_m.template get<MemorySpace>().size() > 0;
+        };
+        sortIndex_m.copyToOtherSpaces<memory_space>(filter);
+
+        // One scratch buffer per memory space, large enough for any of its attributes
+        detail::runForAllSpaces([&]<typename MemorySpace>() {
+            size_type bytes = 0;
+            forAllAttributes<MemorySpace>([&]<typename Attribute>(const Attribute& attribute) {
+                bytes = std::max(bytes, attribute->packedSize(localNum_m));
+            });
+            if (bytes > 0) {
+                growScratch(permuteScratch_m.get<MemorySpace>(), bytes);
+            }
+        });
+
+        forAllAttributes([&]<typename Attribute>(Attribute*& attribute) {
+            using att_memory_space = typename Attribute::memory_space;
+            attribute->applyPermutation(sortIndex_m.get<att_memory_space>(),
+                                        permuteScratch_m.get<att_memory_space>());
+        });
+        Kokkos::fence();
+
+        IpplTimings::stopTimer(sortTimer);
+    }
+
+    template <class PLayout, typename... IP>
+    template <typename Mesh, typename FieldLayout>
+    void ParticleBase<PLayout, IP...>::sort(const Mesh& mesh, const FieldLayout& layout,
+                                            bool useMorton) {
+        constexpr unsigned Dim = PLayout::dim;
+
+        using memory_space    = typename particle_position_type::memory_space;
+        using execution_space = typename particle_position_type::execution_space;
+        using policy_type     = Kokkos::RangePolicy<execution_space>;
+        using key_type        = detail::sfc_key_type;
+
+        const auto& lDom          = layout.getLocalNDIndex();
+        const vector_type& origin = mesh.getOrigin();
+        const vector_type invdx   = 1.0 / mesh.getMeshSpacing();
+
+        Vector<int, Dim> first, length;
+        Vector<key_type, Dim> boxLength;
+        std::size_t maxLength = 0;
+        size_type nKeys       = 1;
+        for (unsigned d = 0; d < Dim; ++d) {
+            first[d]     = lDom[d].first();
+            length[d]    = lDom[d].length();
+            boxLength[d] = length[d];
+            maxLength    = std::max<std::size_t>(maxLength, length[d]);
+            nKeys *= length[d];
+        }
+
+        // Morton keys are replaced by their rank among the local cells, so that
+        // both orders count over the cells only, whatever the shape of the domain
+        const unsigned bits = detail::bitsFor(maxLength);
+
+        Kokkos::View<key_type*, memory_space> keys("ParticleBase::sort keys", localNum_m);
+        const auto& Rattr = R;
+        Kokkos::parallel_for(
+            "Keys in ParticleBase::sort()", policy_type(0, localNum_m),
+            KOKKOS_LAMBDA(const size_t i) {
+                // Particles that have left the local domain are put in the nearest cell
+                Vector<key_type, Dim> cell;
+                for (unsigned d = 0; d < Dim; ++d) {
+                    int c   = Kokkos::floor((Rattr(i)[d] - origin[d]) * invdx[d]) - first[d];
+                    cell[d] = Kokkos::min(Kokkos::max(c, 0), length[d] - 1);
+                }
+
+                if (useMorton) {
+                    keys(i) = detail::mortonRank<Dim>(cell, boxLength, bits);
+                } else {
+                    // Linear cell index in row-major order
+                    key_type key = 0;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        key = key * length[d] + cell[d];
+                    }
+                    keys(i) = key;
+                }
+            });
+
+        sort(keys, nKeys);
+    }
+
     template <class PLayout, typename... IP>
     template <typename HashType>
     void ParticleBase<PLayout, IP...>::sendToRank(int rank, int tag, int sendNum,
@@ -273,7 +533,6 @@ namespace ippl {
         auto hashes = hash_container_type(hash, [&]<typename MemorySpace>() {
             return attributes_m.template get<MemorySpace>().size() > 0;
         });
-        pack(hashes);
         detail::runForAllSpaces([&]<typename MemorySpace>() {
             size_type bufSize = packedSize<MemorySpace>(nSends);
             if (bufSize == 0) {
@@ -282,7 +541,9 @@ namespace ippl {
 
             auto buf = Comm->getBuffer<MemorySpace>(mpi::tag::PARTICLE_SEND + sendNum, bufSize);
 
-            Comm->isend(rank, tag++, *this, *buf, requests.back(), nSends);
+            // The attributes are packed straight into the send buffer
+            pack(*buf, hashes.template get<MemorySpace>());
+            Comm->isend(rank, tag++, *buf, requests.back());
             buf->resetWritePos();
         });
     }
@@ -290,6 +551,8 @@ namespace ippl {
     template <class PLayout, typename... IP>
     void ParticleBase<PLayout, IP...>::recvFromRank(int rank, int tag, int recvNum,
                                                     size_type nRecvs) {
+        growCapacity(localNum_m + nRecvs);
+
         detail::runForAllSpaces([&]<typename MemorySpace>() {
             size_type bufSize = packedSize<MemorySpace>(nRecvs);
             if (bufSize == 0) {
@@ -301,24 +564,72 @@ namespace ippl {
             Comm->recv(rank, tag++, *this, *buf, bufSize, nRecvs);
             buf->resetReadPos();
         });
-        unpack(nRecvs);
+        localNum_m += nRecvs;
     }
 
     template <class PLayout, typename... IP>
-    template <typename Archive>
-    void ParticleBase<PLayout, IP...>::serialize(Archive& ar, size_type nsends) {
-        using memory_space = typename Archive::buffer_type::memory_space;
-        forAllAttributes<memory_space>([&]<typename Attribute>(Attribute& att) {
-            att->serialize(ar, nsends);
+    template <typename HashType>
+    void ParticleBase<PLayout, IP...>::sendToMailbox(int rank, int tag,
+                                                     mpi::SharedMailbox& mailbox,
+                                                     const HashType& hash) {
+        size_type nSends = hash.size();
+
+        auto hashes = hash_container_type(hash, [&]<typename MemorySpace>() {
+            return attributes_m.template get<MemorySpace>().size() > 0;
+        });
+        detail::runForAllSpaces([&]<typename MemorySpace>() {
+            size_type bufSize = packedSize<MemorySpace>(nSends);
+            if (bufSize == 0) {
+                return;
+            }
+
+            using exec_space = typename MemorySpace::execution_space;
+            if constexpr (Kokkos::SpaceAccessibility<exec_space, Kokkos::HostSpace>::accessible) {
+                // The attributes are packed straight into the shared segment
+                detail::Archive<MemorySpace> ar(mailbox.post(rank, tag++, bufSize), bufSize);
+                pack(ar, hashes.template get<MemorySpace>());
+            }
         });
     }
 
+    template <class PLayout, typename... IP>
+    void ParticleBase<PLayout, IP...>::recvFromMailbox(int rank, int tag,
+                                                       mpi::SharedMailbox& mailbox,
+                                                       size_type nRecvs) {
+        growCapacity(localNum_m + nRecvs);
+
+        detail::runForAllSpaces([&]<typename MemorySpace>() {
+            size_type bufSize = packedSize<MemorySpace>(nRecvs);
+            if (bufSize == 0) {
+                return;
+            }
+
+            using exec_space = typename MemorySpace::execution_space;
+            if constexpr (Kokkos::SpaceAccessibility<exec_space, Kokkos::HostSpace>::accessible) {
+                detail::Archive<MemorySpace> ar(mailbox.find(rank, tag++, bufSize), bufSize);
+                deserialize(ar, nRecvs);
+            }
+        });
+        localNum_m += nRecvs;
+    }
+
+    template <class PLayout, typename... IP>
+    bool ParticleBase<PLayout, IP...>::isHostAccessible() const {
+        bool accessible = true;
+        detail::runForAllSpaces([&]<typename MemorySpace>() {
+            using exec_space = typename MemorySpace::execution_space;
+            accessible &= attributes_m.template get<MemorySpace>().size() == 0
+                          || Kokkos::SpaceAccessibility<exec_space, Kokkos::HostSpace>::accessible;
+        });
+        return accessible;
+    }
+
     template <class PLayout, typename... IP>
     template <typename Archive>
     void ParticleBase<PLayout, IP...>::deserialize(Archive& ar, size_type nrecvs) {
         using memory_space = typename Archive::buffer_type::memory_space;
         forAllAttributes<memory_space>([&]<typename Attribute>(Attribute& att) {
-            att->deserialize(ar, nrecvs);
+            att->unpack(ar, nrecvs);
         });
     }
 
@@ -333,23 +644,11 @@ namespace ippl {
     }
 
     template <class PLayout, typename... IP>
-    void ParticleBase<PLayout, IP...>::pack(const hash_container_type& hash) {
-        detail::runForAllSpaces([&]<typename MemorySpace>() {
-            auto& att = attributes_m.template get<MemorySpace>();
-            for (unsigned j = 0; j < att.size(); j++) {
-                att[j]->pack(hash.template get<MemorySpace>());
-            }
-        });
-    }
-
-    template <class PLayout, typename... IP>
-    void ParticleBase<PLayout, IP...>::unpack(size_type nrecvs) {
-        detail::runForAllSpaces([&]<typename MemorySpace>() {
-            auto& att = attributes_m.template get<MemorySpace>();
-            for (unsigned j = 0; j < att.size(); j++) {
-                att[j]->unpack(nrecvs);
-            }
+    template <typename Archive, typename HashType>
+    void ParticleBase<PLayout, IP...>::pack(Archive& ar, const HashType& hash) {
+        using memory_space = typename Archive::buffer_type::memory_space;
+        forAllAttributes<memory_space>([&]<typename Attribute>(Attribute& att) {
+            att->pack(ar, hash);
         });
-        localNum_m += nrecvs;
     }
 }  // namespace ippl
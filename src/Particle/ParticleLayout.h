@@ -53,15 +53,21 @@ namespace ippl {
 
             typedef std::array<BC, 2 * Dim> bc_container_type;
 
+            using bool_type = typename ViewType<bool, 1, position_memory_space>::view_type;
+            using size_type = detail::size_type;
+
             static constexpr unsigned dim = Dim;
 
         public:
-            ParticleLayout() { bcs_m.fill(BC::NO); };
+            ParticleLayout()
+                : absorbSinks_m(false) {
+                bcs_m.fill(BC::NO);
+            };
 
             ~ParticleLayout() = default;
 
             template <class PBase>
-            void update(PBase&) {
+            void update(PBase&, bool = true) {
                 // FIXME
                 std::cout << "TODO" << std::endl;
             }
@@ -78,17 +84,49 @@ namespace ippl {
              */
             void setParticleBC(BC bc) { bcs_m.fill(bc); }
 
+            /*!
+             * @returns the boundary conditions of all faces
+             */
+            const bc_container_type& getParticleBC() const { return bcs_m; }
+
+            /*!
+             * Choose whether update() destroys the particles that reached a sink
+             * face; by default they are kept on the face
+             * @param absorb whether sink faces absorb particles
+             */
+            void setSinkAbsorbing(bool absorb) { absorbSinks_m = absorb; }
+
+            /*!
+             * @returns whether update() destroys the particles that reached a sink face
+             */
+            bool isSinkAbsorbing() const { return absorbSinks_m; }
+
             /*!
              * Apply the given boundary conditions to the current particle positions.
-             * @tparam R is the particle position attribute
-             * @tparam nr is the NDRegion
-             * @param
+             * All faces are handled in a single kernel.
+             * @param R is the particle position attribute
+             * @param nr is the NDRegion
              */
             void applyBC(const particle_position_type& R, const NDRegion<T, Dim>& nr);
 
+            /*!
+             * Apply the given boundary conditions to the current particle positions
+             * and mark the particles that reached a sink face, in a single kernel.
+             * The mask and the count can be passed to the destruction of the bunch.
+             * @param R is the particle position attribute
+             * @param nr is the NDRegion
+             * @param sunk set for each particle to whether it reached a sink face
+             * @returns the number of particles that reached a sink face
+             */
+            size_type applyBC(const particle_position_type& R, const NDRegion<T, Dim>& nr,
+                              const bool_type& sunk);
+
         private:
             //! the list of boundary conditions for this set of particles
             bc_container_type bcs_m;
+
+            //! whether update() destroys the particles that reached a sink face
+            bool absorbSinks_m;
         };
     }  // namespace detail
 }  // namespace ippl
@@ -27,50 +27,48 @@
 //        local atom.  This is not a virtual function, it is a requirement of
 //        the templated class for use in other parts of the code.
 //
+#include <algorithm>
 
 namespace ippl {
     namespace detail {
         template <typename T, unsigned Dim, typename... Properties>
         void ParticleLayout<T, Dim, Properties...>::applyBC(const particle_position_type& R,
                                                             const NDRegion<T, Dim>& nr) {
-            /* loop over all faces
-             * 0: lower x-face
-             * 1: upper x-face
-             * 2: lower y-face
-             * 3: upper y-face
-             * etc...
-             */
-            Kokkos::RangePolicy<typename particle_position_type::execution_space> policy{
-                0, (unsigned)R.getParticleCount()};
-            for (unsigned face = 0; face < 2 * Dim; ++face) {
-                // unsigned face = i % Dim;
-                unsigned d   = face / 2;
-                bool isUpper = face & 1;
-                switch (bcs_m[face]) {
-                    case BC::PERIODIC:
-                        // Periodic faces come in pairs and the application of
-                        // BCs checks both sides, so there is no reason to
-                        // apply periodic conditions twice
-                        if (isUpper) {
-                            break;
-                        }
-
-                        Kokkos::parallel_for("Periodic BC", policy,
-                                             PeriodicBC(R.getView(), nr, d, isUpper));
-                        break;
-                    case BC::REFLECTIVE:
-                        Kokkos::parallel_for("Reflective BC", policy,
-                                             ReflectiveBC(R.getView(), nr, d, isUpper));
-                        break;
-                    case BC::SINK:
-                        Kokkos::parallel_for("Sink BC", policy,
-                                             SinkBC(R.getView(), nr, d, isUpper));
-                        break;
-                    case BC::NO:
-                    default:
-                        break;
-                }
+            if (std::all_of(bcs_m.begin(), bcs_m.end(), [](BC bc) { return bc == BC::NO; })) {
+                return;
             }
+
+            const PositionBC<T, Dim> bc(bcs_m, nr);
+
+            using policy_type = Kokkos::RangePolicy<position_execution_space>;
+            Kokkos::parallel_for(
+                "ParticleLayout::applyBC()", policy_type(0, R.getParticleCount()),
+                KOKKOS_LAMBDA(const size_t i) {
+                    Vector<T, Dim> x = R(i);
+                    bc(x);
+                    R(i) = x;
+                });
+        }
+
+        template <typename T, unsigned Dim, typename... Properties>
+        typename ParticleLayout<T, Dim, Properties...>::size_type
+        ParticleLayout<T, Dim, Properties...>::applyBC(const particle_position_type& R,
+                                                       const NDRegion<T, Dim>& nr,
+                                                       const bool_type& sunk) {
+            const PositionBC<T, Dim> bc(bcs_m, nr);
+
+            size_type sunkCount = 0;
+            using policy_type   = Kokkos::RangePolicy<position_execution_space>;
+            Kokkos::parallel_reduce(
+                "ParticleLayout::applyBC()", policy_type(0, R.getParticleCount()),
+                KOKKOS_LAMBDA(const size_t i, size_type& count) {
+                    Vector<T, Dim> x = R(i);
+                    sunk(i)          = bc(x);
+                    R(i)             = x;
+                    count += sunk(i);
+                },
+                Kokkos::Sum<size_type>(sunkCount));
+            return sunkCount;
         }
     }  // namespace detail
 }  // namespace ippl
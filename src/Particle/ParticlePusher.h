@@ -0,0 +1,119 @@
+//
+// Particle pushers
+//   Fused particle step: the field is interpolated at the particle, the
+//   momentum and the position are advanced and the particle boundary
+//   conditions are applied in one kernel. Every particle is read and written
+//   once per push and the field at the particle is never stored in an
+//   attribute.
+//
+#ifndef IPPL_PARTICLE_PUSHER_H
+#define IPPL_PARTICLE_PUSHER_H
+
+#include "Types/Vector.h"
+
+#include "Interpolation/ShapeFunction.h"
+#include "Particle/ParticleBC.h"
+
+namespace ippl {
+    /*!
+     * Leapfrog kick and drift in the interpolated electric field
+     * @tparam T the coordinate type
+     * @tparam Dim the dimension
+     */
+    template <typename T, unsigned Dim>
+    struct LeapFrogPusher {
+        //! the dimension of the fields and particles
+        static constexpr unsigned dim = Dim;
+
+        //! Charge-to-mass ratio times the time step of the kick
+        T kick_m;
+        //! Time step of the drift; zero for a kick only
+        T drift_m;
+
+        /*!
+         * @param E the electric field at the particle
+         * @param P the particle momentum (velocity)
+         * @param R the particle position
+         */
+        KOKKOS_INLINE_FUNCTION void operator()(const Vector<T, Dim>& E, Vector<T, Dim>& P,
+                                               Vector<T, Dim>& R) const {
+            P += kick_m * E;
+            R += drift_m * P;
+        }
+    };
+
+    /*!
+     * Boris push in the interpolated electric field plus external electric and
+     * magnetic fields: half an electric kick, a rotation about the magnetic
+     * field, the other half of the kick, and the drift. The rotation uses the
+     * cross product, so the pusher is three-dimensional only.
+     * @tparam T the coordinate type
+     * @tparam ExternalE callable returning the external electric field at a position
+     * @tparam ExternalB callable returning the external magnetic field at a position
+     */
+    template <typename T, class ExternalE, class ExternalB>
+    struct BorisPusher {
+        //! the dimension of the fields and particles
+        static constexpr unsigned dim = 3;
+
+        //! Charge-to-mass ratio times the time step of the kick
+        T kick_m;
+        //! Time step of the drift; zero for a kick only
+        T drift_m;
+        ExternalE Eext_m;
+        ExternalB Bext_m;
+
+        /*!
+         * @param E the electric field at the particle
+         * @param P the particle momentum (velocity)
+         * @param R the particle position
+         */
+        KOKKOS_INLINE_FUNCTION void operator()(const Vector<T, 3>& E, Vector<T, 3>& P,
+                                               Vector<T, 3>& R) const {
+            const T h               = 0.5 * kick_m;
+            const Vector<T, 3> Etot = E + Eext_m(R);
+            const Vector<T, 3> t    = h * Bext_m(R);
+            const Vector<T, 3> s    = (T(2) / (T(1) + t.dot(t))) * t;
+
+            const Vector<T, 3> Pminus = P + h * Etot;
+            const Vector<T, 3> Pprime = Pminus + cross(Pminus, t);
+            P                         = Pminus + cross(Pprime, s) + h * Etot;
+            R += drift_m * P;
+        }
+    };
+
+    /*!
+     * Creates a Boris pusher, deducing the types of the external fields
+     * @param kick charge-to-mass ratio times the time step of the kick
+     * @param drift time step of the drift; zero for a kick only
+     * @param Eext the external electric field as a function of the position
+     * @param Bext the external magnetic field as a function of the position
+     */
+    template <typename T, class ExternalE, class ExternalB>
+    BorisPusher<T, ExternalE, ExternalB> makeBorisPusher(T kick, T drift, const ExternalE& Eext,
+                                                         const ExternalB& Bext) {
+        return {kick, drift, Eext, Bext};
+    }
+
+    /*!
+     * Interpolates the field at every particle, advances the momentum and the
+     * position with the pusher and applies the particle boundary conditions,
+     * all in one kernel. The positions are only written back if the pusher
+     * drifts; after a drift, the bunch can be updated with update(false). If the
+     * layout absorbs sinks, the particles that reached a sink face are destroyed.
+     * @tparam Shape the particle shape function (NGP, CIC, TSC or PQS)
+     * @tparam Pusher a device functor (E, P, R) with a drift_m member and the
+     *         dimension dim, which must match the field
+     * @param pusher the pusher
+     * @param E the electric field
+     * @param bunch the particle bunch holding the positions
+     * @param P the momentum attribute of the bunch
+     */
+    template <typename Shape = CIC, typename Pusher, typename Field, typename Bunch,
+              typename Momentum>
+    void pushParticles(const Pusher& pusher, Field& E, Bunch& bunch, Momentum& P);
+}  // namespace ippl
+
+#include "Particle/ParticlePusher.hpp"
+
+#endif
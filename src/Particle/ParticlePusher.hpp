@@ -0,0 +1,100 @@
+//
+// Particle pushers
+//   Fused particle step: the field is interpolated at the particle, the
+//   momentum and the position are advanced and the particle boundary
+//   conditions are applied in one kernel. Every particle is read and written
+//   once per push and the field at the particle is never stored in an
+//   attribute.
+//
+#include "Utility/IpplException.h"
+#include "Utility/IpplTimings.h"
+
+namespace ippl {
+    template <typename Shape, typename Pusher, typename Field, typename Bunch, typename Momentum>
+    void pushParticles(const Pusher& pusher, Field& E, Bunch& bunch, Momentum& P) {
+        constexpr unsigned Dim = Field::dim;
+        using PositionType     = typename Field::Mesh_t::value_type;
+        using T                = typename Bunch::vector_type::value_type;
+        using stencil_type     = detail::Stencil<Shape, PositionType, Dim>;
+        static_assert(Pusher::dim == Dim, "The pusher and the field differ in dimension");
+
+        if (E.getNghost() < Shape::ghostCells) {
+            throw IpplException("pushParticles", "Too few ghost layers for the shape function");
+        }
+
+        static IpplTimings::TimerRef fillHaloTimer = IpplTimings::getTimer("fillHalo");
+        IpplTimings::startTimer(fillHaloTimer);
+        E.fillHalo();
+        IpplTimings::stopTimer(fillHaloTimer);
+
+        static IpplTimings::TimerRef pushTimer = IpplTimings::getTimer("pushParticles");
+        IpplTimings::startTimer(pushTimer);
+        const typename Field::view_type view = E.getView();
+
+        using mesh_type       = typename Field::Mesh_t;
+        const mesh_type& mesh = E.get_mesh();
+
+        using vector_type = typename mesh_type::vector_type;
+
+        const vector_type& dx     = mesh.getMeshSpacing();
+        const vector_type& origin = mesh.getOrigin();
+        const vector_type invdx   = 1.0 / dx;
+
+        const FieldLayout<Dim>& layout = E.getLayout();
+        const NDIndex<Dim>& lDom       = layout.getLocalNDIndex();
+        const int nghost               = E.getNghost();
+
+        // offset from global cell indices to view indices
+        Vector<int, Dim> shift;
+        for (unsigned d = 0; d < Dim; ++d) {
+            shift[d] = nghost - lDom[d].first();
+        }
+
+        const detail::PositionBC<T, Dim> bc(bunch.getParticleBC(),
+                                            bunch.getLayout().getRegionLayout().getDomain());
+        const bool drifts = pusher.drift_m != 0;
+
+        // update(false) skips the boundary conditions of the layout, so the
+        // particles that reach an absorbing sink are marked here and destroyed
+        using size_type   = typename Bunch::size_type;
+        using bool_type   = typename Bunch::Layout_t::bool_type;
+        const bool absorb = drifts && bunch.getLayout().isSinkAbsorbing();
+        bool_type sunk;
+        if (absorb) {
+            sunk = bool_type("sunk", bunch.getLocalNum());
+        }
+
+        // Attribute-level access works with either storage policy
+        const auto& R = bunch.R;
+
+        size_type sunkCount = 0;
+        using policy_type   = Kokkos::RangePolicy<typename Momentum::execution_space>;
+        Kokkos::parallel_reduce(
+            "pushParticles", policy_type(0, bunch.getLocalNum()),
+            KOKKOS_LAMBDA(const size_t i, size_type& count) {
+                Vector<T, Dim> x = R(i);
+                Vector<T, Dim> p = P(i);
+
+                const stencil_type st((x - origin) * invdx, shift);
+                const Vector<T, Dim> e = detail::gatherFromField(st, view);
+
+                pusher(e, p, x);
+                P(i) = p;
+
+                if (drifts) {
+                    const bool reached = bc(x);
+                    R(i)               = x;
+                    if (absorb) {
+                        sunk(i) = reached;
+                        count += reached;
+                    }
+                }
+            },
+            Kokkos::Sum<size_type>(sunkCount));
+        IpplTimings::stopTimer(pushTimer);
+
+        if (sunkCount > 0) {
+            bunch.destroyLocal(sunk, sunkCount);
+        }
+    }
+}  // namespace ippl
@@ -66,8 +66,23 @@ namespace ippl {
 
         void updateLayout(FieldLayout<Dim>&, Mesh&);
 
+        /*!
+         * Applies the boundary conditions and sends the particles to the ranks
+         * owning their positions
+         * @param pc the particle container
+         * @param applyBC whether the boundary conditions still need to be applied;
+         *        false if the positions were constrained when the particles were pushed
+         */
+        template <class ParticleContainer>
+        void update(ParticleContainer& pc, bool applyBC = true);
+
+        /*!
+         * Applies the boundary conditions to the particle positions and, if the
+         * layout absorbs sinks, removes the particles that reached a sink face
+         * @param pc the particle container
+         */
         template <class ParticleContainer>
-        void update(ParticleContainer& pc);
+        void applyParticleBC(ParticleContainer& pc);
 
         const RegionLayout_t& getRegionLayout() const { return rlayout_m; }
 
@@ -43,11 +43,11 @@ namespace ippl {
 
     template <typename T, unsigned Dim, class Mesh, typename... Properties>
     template <class ParticleContainer>
-    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::update(ParticleContainer& pc) {
-        static IpplTimings::TimerRef ParticleBCTimer = IpplTimings::getTimer("particleBC");
-        IpplTimings::startTimer(ParticleBCTimer);
-        this->applyBC(pc.R, rlayout_m.getDomain());
-        IpplTimings::stopTimer(ParticleBCTimer);
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::update(ParticleContainer& pc,
+                                                                    bool applyBC) {
+        if (applyBC) {
+            applyParticleBC(pc);
+        }
 
         static IpplTimings::TimerRef ParticleUpdateTimer = IpplTimings::getTimer("updateParticle");
         IpplTimings::startTimer(ParticleUpdateTimer);
@@ -114,15 +114,42 @@ namespace ippl {
 
         int tag = Comm->next_tag(mpi::tag::P_SPATIAL_LAYOUT, mpi::tag::P_LAYOUT_CYCLE);
 
+        // Particles for ranks on the same node go through shared memory
+        mpi::SharedMailbox* mailbox = pc.isHostAccessible() ? Comm->getSharedMailbox() : nullptr;
+        if (mailbox) {
+            size_type nMessages = 0, nBytes = 0;
+            for (int rank = 0; rank < nRanks; ++rank) {
+                if (nSends[rank] == 0 || !mailbox->isLocal(rank)) {
+                    continue;
+                }
+                detail::runForAllSpaces([&]<typename MemorySpace>() {
+                    size_type size = pc.template packedSize<MemorySpace>(nSends[rank]);
+                    if (size > 0) {
+                        ++nMessages;
+                        nBytes += mailbox->paddedSize(size);
+                    }
+                });
+            }
+            mailbox->begin(nMessages, nBytes);
+        }
+
         int sends = 0;
         for (int rank = 0; rank < nRanks; ++rank) {
             if (nSends[rank] > 0) {
                 hash_type hash("hash", nSends[rank]);
                 fillHash(rank, ranks, hash);
 
-                pc.sendToRank(rank, tag, sends++, requests, hash);
+                if (mailbox && mailbox->isLocal(rank)) {
+                    pc.sendToMailbox(rank, tag, *mailbox, hash);
+                } else {
+                    pc.sendToRank(rank, tag, sends++, requests, hash);
+                }
             }
         }
+
+        if (mailbox) {
+            mailbox->publish();
+        }
         IpplTimings::stopTimer(sendTimer);
 
         // 3rd step
@@ -137,9 +164,18 @@ namespace ippl {
         static IpplTimings::TimerRef recvTimer = IpplTimings::getTimer("particleRecv");
         IpplTimings::startTimer(recvTimer);
         // 4th step
+        // Grow all attributes once for all incoming particles
+        pc.growCapacity(pc.getLocalNum()
+                        + std::accumulate(nRecvs.begin(), nRecvs.end(), size_type(0)));
+
         int recvs = 0;
         for (int rank = 0; rank < nRanks; ++rank) {
-            if (nRecvs[rank] > 0) {
+            if (nRecvs[rank] == 0) {
+                continue;
+            }
+            if (mailbox && mailbox->isLocal(rank)) {
+                pc.recvFromMailbox(rank, tag, *mailbox, nRecvs[rank]);
+            } else {
                 pc.recvFromRank(rank, tag, recvs++, nRecvs[rank]);
             }
         }
@@ -155,6 +191,25 @@ namespace ippl {
         IpplTimings::stopTimer(ParticleUpdateTimer);
     }
 
+    template <typename T, unsigned Dim, class Mesh, typename... Properties>
+    template <class ParticleContainer>
+    void ParticleSpatialLayout<T, Dim, Mesh, Properties...>::applyParticleBC(
+        ParticleContainer& pc) {
+        static IpplTimings::TimerRef ParticleBCTimer = IpplTimings::getTimer("particleBC");
+        IpplTimings::startTimer(ParticleBCTimer);
+        if (this->isSinkAbsorbing()) {
+            // The particles that reached a sink face are marked by the same kernel
+            bool_type sunk("sunk", pc.getLocalNum());
+            size_type sunkCount = this->applyBC(pc.R, rlayout_m.getDomain(), sunk);
+            if (sunkCount > 0) {
+                pc.destroyLocal(sunk, sunkCount);
+            }
+        } else {
+            this->applyBC(pc.R, rlayout_m.getDomain());
+        }
+        IpplTimings::stopTimer(ParticleBCTimer);
+    }
+
     template <typename T, unsigned Dim, class Mesh, typename... Properties>
     template <size_t... Idx>
     KOKKOS_INLINE_FUNCTION constexpr bool
@@ -167,7 +222,7 @@ namespace ippl {
     template <typename ParticleContainer>
     detail::size_type ParticleSpatialLayout<T, Dim, Mesh, Properties...>::locateParticles(
         const ParticleContainer& pc, locate_type& ranks, bool_type& invalid) const {
-        auto& positions                            = pc.R.getView();
+        const auto& R                              = pc.R;
         typename RegionLayout_t::view_type Regions = rlayout_m.getdLocalRegions();
 
         using mdrange_type = Kokkos::MDRangePolicy<Kokkos::Rank<2>, position_execution_space>;
@@ -181,7 +236,7 @@ namespace ippl {
             "ParticleSpatialLayout::locateParticles()",
             mdrange_type({0, 0}, {ranks.extent(0), Regions.extent(0)}),
             KOKKOS_LAMBDA(const size_t i, const size_type j, size_type& count) {
-                bool xyz_bool = positionInRegion(is, positions(i), Regions(j));
+                bool xyz_bool = positionInRegion(is, R(i), Regions(j));
                 if (xyz_bool) {
                     ranks(i)   = j;
                     invalid(i) = (myRank != ranks(i));
@@ -0,0 +1,91 @@
+//
+// Class ParticleSpeciesGroup
+//   Several particle bunches (species) that share one spatial layout and are
+//   redistributed together.
+//
+//   Simulations with several species (e.g. electrons and ions) keep one bunch
+//   per species. Updating each bunch on its own repeats the whole exchange per
+//   species: one window epoch for the send counts and one message per
+//   destination rank for every species. A species group updates all bunches in
+//   one migration round. The send counts of all species are exchanged in a
+//   single window epoch and the particles of all species going to the same rank
+//   travel in the same message.
+//
+//     ParticleSpeciesGroup<Electrons, Ions> species(electrons, ions);
+//     ...
+//     species.update();
+//
+//   The bunches must have been initialized with the same ParticleSpatialLayout.
+//
+#ifndef IPPL_PARTICLE_SPECIES_GROUP_H
+#define IPPL_PARTICLE_SPECIES_GROUP_H
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Types/IpplTypes.h"
+
+#include "Particle/ParticleBase.h"
+
+namespace ippl {
+
+    /*!
+     * @class ParticleSpeciesGroup
+     * @tparam Bunches the particle container types of the species
+     */
+    template <class... Bunches>
+    class ParticleSpeciesGroup {
+        using first_type = std::tuple_element_t<0, std::tuple<Bunches...>>;
+
+    public:
+        using Layout_t  = typename first_type::Layout_t;
+        using size_type = detail::size_type;
+
+        static_assert((std::is_same_v<typename Bunches::Layout_t, Layout_t> && ...),
+                      "All species must use the same layout type");
+
+        //! The number of species in the group
+        constexpr static unsigned nSpecies = sizeof...(Bunches);
+
+        /*!
+         * @param bunches the species, initialized with the same layout
+         */
+        ParticleSpeciesGroup(Bunches&... bunches);
+
+        //! @returns the species with the given index
+        template <unsigned S>
+        auto& get() {
+            return *std::get<S>(bunches_m);
+        }
+
+        Layout_t& getLayout() { return get<0>().getLayout(); }
+
+        /*!
+         * Redistribute the particles of all species among the ranks in one
+         * migration round. This is a collective call.
+         * @param applyBC whether the layout applies the boundary conditions first
+         */
+        void update(bool applyBC = true);
+
+    private:
+        using locate_type = typename Layout_t::locate_type;
+        using bool_type   = typename Layout_t::bool_type;
+        using hash_type   = typename Layout_t::hash_type;
+
+        using hash_container_type = typename first_type::hash_container_type;
+
+        /*!
+         * Calls the functor with each species and its index
+         */
+        template <typename Functor>
+        void forAllSpecies(Functor&& f);
+
+        std::tuple<Bunches*...> bunches_m;
+    };
+}  // namespace ippl
+
+#include "Particle/ParticleSpeciesGroup.hpp"
+
+#endif
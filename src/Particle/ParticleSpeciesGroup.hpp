@@ -0,0 +1,206 @@
+//
+// Class ParticleSpeciesGroup
+//   Several particle bunches (species) that share one spatial layout and are
+//   redistributed together.
+//
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "Utility/IpplException.h"
+#include "Utility/IpplTimings.h"
+
+#include "Communicate/Window.h"
+
+namespace ippl {
+
+    template <class... Bunches>
+    ParticleSpeciesGroup<Bunches...>::ParticleSpeciesGroup(Bunches&... bunches)
+        : bunches_m(&bunches...) {
+        const Layout_t* layout = &getLayout();
+        forAllSpecies([&]<typename Bunch>(Bunch& bunch, unsigned) {
+            if (&bunch.getLayout() != layout) {
+                throw IpplException("ParticleSpeciesGroup::ParticleSpeciesGroup",
+                                    "All species must share the same layout");
+            }
+        });
+    }
+
+    template <class... Bunches>
+    template <typename Functor>
+    void ParticleSpeciesGroup<Bunches...>::forAllSpecies(Functor&& f) {
+        [&]<size_t... S>(const std::index_sequence<S...>&) {
+            (f(*std::get<S>(bunches_m), S), ...);
+        }(std::index_sequence_for<Bunches...>{});
+    }
+
+    template <class... Bunches>
+    void ParticleSpeciesGroup<Bunches...>::update(bool applyBC) {
+        Layout_t& layout = getLayout();
+
+        if (applyBC) {
+            forAllSpecies([&]<typename Bunch>(Bunch& bunch, unsigned) {
+                layout.applyParticleBC(bunch);
+            });
+        }
+
+        static IpplTimings::TimerRef ParticleUpdateTimer = IpplTimings::getTimer("updateParticle");
+        IpplTimings::startTimer(ParticleUpdateTimer);
+        const int nRanks = Comm->size();
+        const int myRank = Comm->rank();
+
+        if (nRanks > 1) {
+            // 1st step: locate the particles of every species
+            static IpplTimings::TimerRef locateTimer = IpplTimings::getTimer("locateParticles");
+            IpplTimings::startTimer(locateTimer);
+            std::array<locate_type, nSpecies> ranks;
+            std::array<bool_type, nSpecies> invalid;
+            std::array<size_type, nSpecies> invalidCount;
+            forAllSpecies([&]<typename Bunch>(Bunch& bunch, unsigned s) {
+                ranks[s]        = locate_type("MPI ranks", bunch.getLocalNum());
+                invalid[s]      = bool_type("invalid", bunch.getLocalNum());
+                invalidCount[s] = layout.locateParticles(bunch, ranks[s], invalid[s]);
+            });
+            IpplTimings::stopTimer(locateTimer);
+
+            // 2nd step: exchange the send counts of all species in one window epoch;
+            // entry rank * nSpecies + s holds the number of particles of species s
+            static IpplTimings::TimerRef preprocTimer = IpplTimings::getTimer("sendPreprocess");
+            IpplTimings::startTimer(preprocTimer);
+            mpi::rma::Window<mpi::rma::Active> window;
+            std::vector<size_type> nRecvs(nRanks * nSpecies, 0);
+            window.create(*Comm, nRecvs.begin(), nRecvs.end());
+
+            std::vector<size_type> nSends(nRanks * nSpecies, 0);
+
+            window.fence(0);
+            for (int rank = 0; rank < nRanks; ++rank) {
+                if (rank == myRank) {
+                    continue;
+                }
+                auto first = nSends.begin() + rank * nSpecies;
+                for (unsigned s = 0; s < nSpecies; ++s) {
+                    first[s] = layout.numberOfSends(rank, ranks[s]);
+                }
+                window.put(first, first + nSpecies, rank, myRank * nSpecies);
+            }
+            window.fence(0);
+            IpplTimings::stopTimer(preprocTimer);
+
+            // Send the particles of all species going to a rank in one message
+            // per memory space
+            static IpplTimings::TimerRef sendTimer = IpplTimings::getTimer("particleSend");
+            IpplTimings::startTimer(sendTimer);
+            std::vector<MPI_Request> requests(0);
+
+            const int tag = Comm->next_tag(mpi::tag::P_SPATIAL_LAYOUT, mpi::tag::P_LAYOUT_CYCLE);
+
+            int sends = 0;
+            for (int rank = 0; rank < nRanks; ++rank) {
+                const size_type* counts = nSends.data() + rank * nSpecies;
+                if (std::accumulate(counts, counts + nSpecies, size_type(0)) == 0) {
+                    continue;
+                }
+
+                std::array<hash_container_type, nSpecies> hashes;
+                forAllSpecies([&]<typename Bunch>(Bunch& bunch, unsigned s) {
+                    hash_type hash("hash", counts[s]);
+                    layout.fillHash(rank, ranks[s], hash);
+                    hashes[s] = hash_container_type(hash, [&]<typename MemorySpace>() {
+                        return bunch.template packedSize<MemorySpace>(1) > 0;
+                    });
+                });
+
+                int msgTag = tag;
+                detail::runForAllSpaces([&]<typename MemorySpace>() {
+                    size_type bufSize = 0;
+                    forAllSpecies([&]<typename Bunch>(Bunch& bunch, unsigned s) {
+                        bufSize += bunch.template packedSize<MemorySpace>(counts[s]);
+                    });
+                    if (bufSize == 0) {
+                        return;
+                    }
+
+                    auto buf =
+                        Comm->getBuffer<MemorySpace>(mpi::tag::PARTICLE_SEND + sends, bufSize);
+                    forAllSpecies([&]<typename Bunch>(Bunch& bunch, unsigned s) {
+                        if (counts[s] > 0) {
+                            bunch.pack(*buf, hashes[s].template get<MemorySpace>());
+                        }
+                    });
+                    requests.resize(requests.size() + 1);
+                    Comm->isend(rank, msgTag++, *buf, requests.back());
+                    buf->resetWritePos();
+                });
+                ++sends;
+            }
+            IpplTimings::stopTimer(sendTimer);
+
+            // 3rd step: delete the particles that were sent
+            static IpplTimings::TimerRef destroyTimer = IpplTimings::getTimer("particleDestroy");
+            IpplTimings::startTimer(destroyTimer);
+            forAllSpecies([&]<typename Bunch>(Bunch& bunch, unsigned s) {
+                bunch.internalDestroy(invalid[s], invalidCount[s]);
+            });
+            Kokkos::fence();
+            IpplTimings::stopTimer(destroyTimer);
+
+            // 4th step: receive one message per source rank and memory space and
+            // unpack the species in the order in which they were packed
+            static IpplTimings::TimerRef recvTimer = IpplTimings::getTimer("particleRecv");
+            IpplTimings::startTimer(recvTimer);
+            forAllSpecies([&]<typename Bunch>(Bunch& bunch, unsigned s) {
+                size_type total = 0;
+                for (int rank = 0; rank < nRanks; ++rank) {
+                    total += nRecvs[rank * nSpecies + s];
+                }
+                bunch.growCapacity(bunch.getLocalNum() + total);
+            });
+
+            int recvs = 0;
+            for (int rank = 0; rank < nRanks; ++rank) {
+                const size_type* counts = nRecvs.data() + rank * nSpecies;
+                if (std::accumulate(counts, counts + nSpecies, size_type(0)) == 0) {
+                    continue;
+                }
+
+                int msgTag = tag;
+                detail::runForAllSpaces([&]<typename MemorySpace>() {
+                    size_type bufSize = 0;
+                    forAllSpecies([&]<typename Bunch>(Bunch& bunch, unsigned s) {
+                        bufSize += bunch.template packedSize<MemorySpace>(counts[s]);
+                    });
+                    if (bufSize == 0) {
+                        return;
+                    }
+
+                    auto buf =
+                        Comm->getBuffer<MemorySpace>(mpi::tag::PARTICLE_RECV + recvs, bufSize);
+                    Comm->recv(rank, msgTag++, *buf, bufSize);
+                    forAllSpecies([&]<typename Bunch>(Bunch& bunch, unsigned s) {
+                        if (counts[s] > 0) {
+                            bunch.deserialize(*buf, counts[s]);
+                        }
+                    });
+                    buf->resetReadPos();
+                });
+                forAllSpecies([&]<typename Bunch>(Bunch& bunch, unsigned s) {
+                    bunch.setLocalNum(bunch.getLocalNum() + counts[s]);
+                });
+                ++recvs;
+            }
+            IpplTimings::stopTimer(recvTimer);
+
+            IpplTimings::startTimer(sendTimer);
+            if (requests.size() > 0) {
+                MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+            }
+            IpplTimings::stopTimer(sendTimer);
+        }
+        IpplTimings::stopTimer(ParticleUpdateTimer);
+
+        forAllSpecies([&]<typename Bunch>(Bunch& bunch, unsigned) {
+            bunch.releaseCapacity();
+        });
+    }
+}  // namespace ippl
@@ -5,9 +5,27 @@
 #ifndef IPPL_PARTITIONER_H
 #define IPPL_PARTITIONER_H
 
+#include <array>
+#include <vector>
+
 #include "Index/NDIndex.h"
 
 namespace ippl {
+    /*!
+     * How a domain is partitioned among the ranks
+     *   BISECTION   - recursive bisection of the domain
+     *   MIN_SURFACE - the processor grid with the fewest ghost cells facing other ranks
+     *   PENCIL      - like MIN_SURFACE, but at least one axis is not split, so that
+     *                 heFFTe starts from pencils without reshaping
+     *   SLAB        - like MIN_SURFACE, but only one axis is split
+     */
+    enum class PartitionStrategy {
+        BISECTION,
+        MIN_SURFACE,
+        PENCIL,
+        SLAB
+    };
+
     namespace detail {
 
         template <unsigned Dim>
@@ -16,10 +34,66 @@ namespace ippl {
             Partitioner()  = default;
             ~Partitioner() = default;
 
+            /*!
+             * Partitions the domain into the given number of subdomains. The grid
+             * strategies fall back to bisection if no processor grid fits the domain.
+             * @param domain the domain to partition
+             * @param view the view receiving the subdomains
+             * @param isParallel the axes that may be split
+             * @param nSplits the number of subdomains
+             * @param strategy the partitioning strategy
+             * @param nghost the number of ghost layers the processor grid is optimized for
+             * @param capacities the relative speed of each rank; if given, the domain is
+             * bisected so that each rank's share of the cells is proportional to its speed
+             */
             template <typename view_type>
             void split(const NDIndex<Dim>& domain, view_type& view,
-                       const std::array<bool, Dim>& isParallel,
-                       int nSplits) const;
+                       const std::array<bool, Dim>& isParallel, int nSplits,
+                       PartitionStrategy strategy = PartitionStrategy::BISECTION,
+                       int nghost = 1, const std::vector<double>& capacities = {}) const;
+
+            /*!
+             * Partitions the domain in two levels: first among the nodes, in
+             * proportion to their number of ranks (or capacities), and then the part
+             * of each node among its ranks. The ranks of a node thus own adjacent
+             * subdomains and most of their halo exchange stays on the node.
+             * @param domain the domain to partition
+             * @param view the view receiving the subdomains
+             * @param isParallel the axes that may be split
+             * @param nSplits the number of subdomains
+             * @param nodeIds the node index of each rank
+             * @param strategy the partitioning strategy used on both levels
+             * @param nghost the number of ghost layers the processor grid is optimized for
+             * @param capacities the relative speed of each rank (default: all equal)
+             */
+            template <typename view_type>
+            void splitHierarchical(const NDIndex<Dim>& domain, view_type& view,
+                                   const std::array<bool, Dim>& isParallel, int nSplits,
+                                   const std::vector<int>& nodeIds,
+                                   PartitionStrategy strategy = PartitionStrategy::BISECTION,
+                                   int nghost                            = 1,
+                                   const std::vector<double>& capacities = {}) const;
+
+        private:
+            /*!
+             * Finds the processor grid allowed by the strategy with the smallest
+             * number of ghost cells adjacent to other ranks
+             * @param grid the number of subdomains along each axis
+             * @return Whether such a grid exists
+             */
+            bool findGrid(const NDIndex<Dim>& domain, const std::array<bool, Dim>& isParallel,
+                          int nSplits, PartitionStrategy strategy, int nghost,
+                          std::array<int, Dim>& grid) const;
+
+            /*!
+             * Recursively bisects the domain of the ranks [lo, hi) along its longest
+             * parallel axis, dividing the cells in proportion to the capacities of
+             * the ranks [lo, mid) and [mid, hi)
+             */
+            template <typename view_type>
+            void bisectWeighted(const NDIndex<Dim>& domain, view_type& view,
+                                const std::array<bool, Dim>& isParallel,
+                                const std::vector<double>& capacities, int lo, int hi) const;
         };
     }  // namespace detail
 }  // namespace ippl
@@ -4,19 +4,148 @@
 //
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
 #include <vector>
 
+#include "Utility/IpplException.h"
+
 namespace ippl {
     namespace detail {
 
+        template <unsigned Dim>
+        bool Partitioner<Dim>::findGrid(const NDIndex<Dim>& domain,
+                                        const std::array<bool, Dim>& isParallel, int nSplits,
+                                        PartitionStrategy strategy, int nghost,
+                                        std::array<int, Dim>& grid) const {
+            double minCost = std::numeric_limits<double>::max();
+            std::array<int, Dim> current;
+
+            // Enumerate the factorizations of nSplits into Dim factors
+            auto search = [&](auto& self, unsigned d, int remaining) -> void {
+                if (d == Dim) {
+                    if (remaining > 1) {
+                        return;
+                    }
+                    unsigned splitAxes = 0;
+                    for (unsigned a = 0; a < Dim; ++a) {
+                        splitAxes += current[a] > 1;
+                    }
+                    if ((strategy == PartitionStrategy::PENCIL && splitAxes == Dim)
+                        || (strategy == PartitionStrategy::SLAB && splitAxes > 1)) {
+                        return;
+                    }
+
+                    // Ghost cells of the largest subdomain along the split axes
+                    double inner = 1, outer = 1;
+                    for (unsigned a = 0; a < Dim; ++a) {
+                        const double length =
+                            (domain[a].length() + current[a] - 1) / current[a];
+                        inner *= length;
+                        outer *= length + (current[a] > 1 ? 2 * nghost : 0);
+                    }
+                    if (outer - inner < minCost) {
+                        minCost = outer - inner;
+                        grid    = current;
+                    }
+                    return;
+                }
+
+                const int maxFactor = isParallel[d] ? remaining : 1;
+                for (int p = 1; p <= maxFactor; ++p) {
+                    if (remaining % p == 0 && p <= static_cast<int>(domain[d].length())) {
+                        current[d] = p;
+                        self(self, d + 1, remaining / p);
+                    }
+                }
+            };
+            search(search, 0, nSplits);
+
+            return minCost < std::numeric_limits<double>::max();
+        }
+
+        template <unsigned Dim>
+        template <typename view_type>
+        void Partitioner<Dim>::bisectWeighted(const NDIndex<Dim>& domain, view_type& view,
+                                              const std::array<bool, Dim>& isParallel,
+                                              const std::vector<double>& capacities, int lo,
+                                              int hi) const {
+            if (hi - lo == 1) {
+                view(lo) = domain;
+                return;
+            }
+
+            unsigned axis = 0;
+            long length   = 0;
+            for (unsigned d = 0; d < Dim; ++d) {
+                if (isParallel[d] && domain[d].length() > length) {
+                    length = domain[d].length();
+                    axis   = d;
+                }
+            }
+
+            // Same division of the ranks as the ORB, see DomainTree
+            const int mid      = lo + (hi - lo) / 2;
+            auto first         = capacities.begin();
+            const double left  = std::accumulate(first + lo, first + mid, 0.0);
+            const double total = std::accumulate(first + mid, first + hi, left);
+            const double ratio = total > 0 ? left / total : double(mid - lo) / (hi - lo);
+
+            // Leave at least one cell per rank on each side if possible
+            long minLeft = mid - lo;
+            long maxLeft = length - (hi - mid);
+            if (minLeft > maxLeft) {
+                minLeft = 1;
+                maxLeft = length - 1;
+            }
+            const long leftSize = std::clamp<long>(std::lround(ratio * length), minLeft, maxLeft);
+
+            NDIndex<Dim> leftDomain, rightDomain;
+            domain.split(leftDomain, rightDomain, axis, domain[axis].first() + leftSize - 1);
+            bisectWeighted(leftDomain, view, isParallel, capacities, lo, mid);
+            bisectWeighted(rightDomain, view, isParallel, capacities, mid, hi);
+        }
+
         template <unsigned Dim>
         template <typename view_type>
         void Partitioner<Dim>::split(const NDIndex<Dim>& domain, view_type& view,
-                                     const std::array<bool, Dim>& isParallel,
-                                     int nSplits) const {
+                                     const std::array<bool, Dim>& isParallel, int nSplits,
+                                     PartitionStrategy strategy, int nghost,
+                                     const std::vector<double>& capacities) const {
             using NDIndex_t = NDIndex<Dim>;
 
+            if (!capacities.empty()) {
+                if (capacities.size() < static_cast<size_t>(nSplits)) {
+                    throw IpplException("Partitioner::split",
+                                        "A capacity is needed for every subdomain");
+                }
+                // The processor grids split the axes evenly, so unequal ranks are
+                // always served by the weighted bisection
+                bisectWeighted(domain, view, isParallel, capacities, 0, nSplits);
+                return;
+            }
+
+            std::array<int, Dim> grid;
+            if (strategy != PartitionStrategy::BISECTION
+                && findGrid(domain, isParallel, nSplits, strategy, nghost, grid)) {
+                // Split every axis evenly; the subdomains are numbered with the
+                // first axis running fastest
+                for (int i = 0; i < nSplits; ++i) {
+                    NDIndex_t& subdomain = view(i);
+                    int rest             = i;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        const int k      = rest % grid[d];
+                        const long first = domain[d].first();
+                        const long n     = domain[d].length();
+                        rest /= grid[d];
+                        subdomain[d] =
+                            Index(first + n * k / grid[d], first + n * (k + 1) / grid[d] - 1);
+                    }
+                }
+                return;
+            }
+
             // Recursively split the domain until we have generated all the domains.
             std::vector<NDIndex_t> domains_c(nSplits);
             NDIndex_t leftDomain;
@@ -122,5 +251,66 @@ namespace ippl {
                 view(i) = domains_c[i];
             }
         }
+
+        template <unsigned Dim>
+        template <typename view_type>
+        void Partitioner<Dim>::splitHierarchical(const NDIndex<Dim>& domain, view_type& view,
+                                                 const std::array<bool, Dim>& isParallel,
+                                                 int nSplits, const std::vector<int>& nodeIds,
+                                                 PartitionStrategy strategy, int nghost,
+                                                 const std::vector<double>& capacities) const {
+            using domain_view = Kokkos::View<NDIndex<Dim>*, Kokkos::HostSpace>;
+
+            if (nodeIds.size() < static_cast<size_t>(nSplits)) {
+                throw IpplException("Partitioner::splitHierarchical",
+                                    "A node index is needed for every subdomain");
+            }
+
+            // The ranks of each node, leaving out nodes without subdomains
+            std::vector<std::vector<int>> nodeRanks;
+            std::vector<int> nodeOf(*std::max_element(nodeIds.begin(), nodeIds.end()) + 1, -1);
+            for (int rank = 0; rank < nSplits; ++rank) {
+                int& node = nodeOf[nodeIds[rank]];
+                if (node < 0) {
+                    node = nodeRanks.size();
+                    nodeRanks.emplace_back();
+                }
+                nodeRanks[node].push_back(rank);
+            }
+            const int nNodes = nodeRanks.size();
+
+            // Nodes with different numbers of ranks, or ranks of different speed,
+            // receive parts proportional to their total capacity
+            std::vector<double> nodeCapacities(nNodes);
+            bool isUniform = capacities.empty();
+            for (int node = 0; node < nNodes; ++node) {
+                for (int rank : nodeRanks[node]) {
+                    nodeCapacities[node] += capacities.empty() ? 1.0 : capacities[rank];
+                }
+                isUniform &= nodeRanks[node].size() == nodeRanks[0].size();
+            }
+
+            domain_view nodeDomains("node domains", nNodes);
+            split(domain, nodeDomains, isParallel, nNodes, strategy, nghost,
+                  isUniform ? std::vector<double>{} : nodeCapacities);
+
+            for (int node = 0; node < nNodes; ++node) {
+                const std::vector<int>& ranks = nodeRanks[node];
+
+                std::vector<double> rankCapacities;
+                if (!capacities.empty()) {
+                    for (int rank : ranks) {
+                        rankCapacities.push_back(capacities[rank]);
+                    }
+                }
+
+                domain_view local("rank domains", ranks.size());
+                split(nodeDomains(node), local, isParallel, ranks.size(), strategy, nghost,
+                      rankCapacities);
+                for (size_t i = 0; i < ranks.size(); ++i) {
+                    view(ranks[i]) = local(i);
+                }
+            }
+        }
     }  // namespace detail
 }  // namespace ippl
@@ -8,6 +8,8 @@
 #ifndef IPPL_FFT_OPEN_POISSON_SOLVER_H_
 #define IPPL_FFT_OPEN_POISSON_SOLVER_H_
 
+#include <algorithm>
+
 #include <Kokkos_MathematicalConstants.hpp>
 #include <Kokkos_MathematicalFunctions.hpp>
 
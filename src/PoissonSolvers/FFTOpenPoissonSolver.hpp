@@ -15,8 +15,8 @@ void pack(const ippl::NDIndex<3> intersect, Kokkos::View<Tf***>& view,
     size_t size = intersect.size();
     nsends      = size;
     if (buffer.size() < size) {
-        const int overalloc = ippl::Comm->getDefaultOverallocation();
-        Kokkos::realloc(buffer, size * overalloc);
+        const double overalloc = std::max(1.0, ippl::Comm->getDefaultOverallocation());
+        Kokkos::realloc(buffer, size_t(size * overalloc));
     }
 
     const int first0 = intersect[0].first() + nghost - ldom[0].first();
@@ -53,8 +53,9 @@ namespace ippl {
         KOKKOS_FUNCTION
         Vector(const std::initializer_list<T>& list);
 
-        KOKKOS_FUNCTION
-        ~Vector() {}
+        // Defaulted so that vectors are trivially copyable
+        KOKKOS_DEFAULTED_FUNCTION
+        ~Vector() = default;
 
         // Get and Set Operations
         KOKKOS_INLINE_FUNCTION value_type& operator[](unsigned int i);
@@ -47,6 +47,10 @@ namespace ippl {
 
         template <typename MemorySpace>
         using hash_type = typename detail::ViewType<int, 1, MemorySpace>::view_type;
+
+        //! Untyped scratch memory that can be shared by views of different types
+        template <typename MemorySpace>
+        using scratch_type = typename detail::ViewType<char, 1, MemorySpace>::view_type;
     }  // namespace detail
 }  // namespace ippl
 
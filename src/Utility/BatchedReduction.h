@@ -0,0 +1,170 @@
+//
+// Batched reductions
+//   Reduce several expressions over the same index range in a single kernel
+//   and a single collective. Every call of sum() or max() on an attribute or a
+//   field launches its own kernel followed by its own allreduce. Diagnostics
+//   that need several quantities per step can instead write
+//
+//     auto [charge, qmax, ekin] =
+//         ippl::reduceParticles(P->getLocalNum(), ippl::sumOf(P->q), ippl::maxOf(P->q),
+//                               ippl::sumOf(dot(P->P, P->P)));
+//
+//     auto [energy, emax] = rho.reduce(ippl::sumOf(rho * rho), ippl::maxOf(fabs(rho)));
+//
+//   Moments are sums of products, e.g. sumOf(q * x * x). The results are
+//   converted to the common type of the terms.
+//
+#ifndef IPPL_BATCHED_REDUCTION_H
+#define IPPL_BATCHED_REDUCTION_H
+
+#include <Kokkos_Core.hpp>
+
+#include <array>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "Expression/IpplExpressions.h"
+#include "Utility/ParallelDispatch.h"
+
+namespace ippl {
+    //! The operations of a batched reduction
+    enum class ReductionOp {
+        SUM,
+        MAX,
+        MIN,
+        PROD
+    };
+
+    namespace detail {
+        /*!
+         * An expression to be reduced with the given operation
+         * @tparam Op the reduction operation
+         * @tparam E the expression type
+         * @tparam N the size of the expression
+         */
+        template <ReductionOp Op, typename E, size_t N>
+        struct ReductionTerm {
+            constexpr static ReductionOp op = Op;
+
+            using capture_type = CapturedExpression<E, N>;
+
+            capture_type expr_m;
+        };
+
+        template <ReductionOp Op, typename T>
+        struct ReductionTraits;
+
+        template <typename T>
+        struct ReductionTraits<ReductionOp::SUM, T> {
+            using reducer_type = Kokkos::Sum<T>;
+
+            KOKKOS_INLINE_FUNCTION static void combine(T& acc, const T& val) { acc += val; }
+        };
+
+        template <typename T>
+        struct ReductionTraits<ReductionOp::MAX, T> {
+            using reducer_type = Kokkos::Max<T>;
+
+            KOKKOS_INLINE_FUNCTION static void combine(T& acc, const T& val) {
+                if (val > acc) {
+                    acc = val;
+                }
+            }
+        };
+
+        template <typename T>
+        struct ReductionTraits<ReductionOp::MIN, T> {
+            using reducer_type = Kokkos::Min<T>;
+
+            KOKKOS_INLINE_FUNCTION static void combine(T& acc, const T& val) {
+                if (val < acc) {
+                    acc = val;
+                }
+            }
+        };
+
+        template <typename T>
+        struct ReductionTraits<ReductionOp::PROD, T> {
+            using reducer_type = Kokkos::Prod<T>;
+
+            KOKKOS_INLINE_FUNCTION static void combine(T& acc, const T& val) { acc *= val; }
+        };
+
+        //! The type of a term evaluated at an index of the given index array type
+        template <class Index, typename Term>
+        using term_value_type = std::remove_cv_t<std::remove_reference_t<decltype(apply(
+            std::declval<const typename Term::capture_type&>(), std::declval<const Index&>()))>>;
+
+        /*!
+         * Combines the results of the terms of two ranks (used as the MPI operation)
+         */
+        template <typename T, typename... Terms>
+        struct CombineReductions {
+            void operator()(std::array<T, sizeof...(Terms)>& inout,
+                            const std::array<T, sizeof...(Terms)>& in) const {
+                size_t k = 0;
+                ((ReductionTraits<Terms::op, T>::combine(inout[k], in[k]), ++k), ...);
+            }
+        };
+
+        template <typename T, class Policy, size_t... Idx, typename... Terms>
+        std::array<T, sizeof...(Terms)> reduceLocal(const std::string& name,
+                                                    const Policy& policy,
+                                                    std::index_sequence<Idx...>,
+                                                    const Terms&... terms) {
+            constexpr unsigned Dim = ExtractRank<Policy>::rank;
+            using index_array_type =
+                typename RangePolicy<Dim, typename Policy::execution_space>::index_array_type;
+
+            std::array<T, sizeof...(Terms)> local;
+            ippl::parallel_reduce(
+                name, policy,
+                KOKKOS_LAMBDA(const index_array_type& args, auto&... acc) {
+                    (ReductionTraits<Terms::op, T>::combine(acc, T(apply(terms.expr_m, args))),
+                     ...);
+                },
+                typename ReductionTraits<Terms::op, T>::reducer_type(local[Idx])...);
+            return local;
+        }
+
+        /*!
+         * Reduces the terms over the local index range in one kernel and over all
+         * ranks in one collective
+         * @param comm the communicator of the ranks
+         * @param policy the local index range
+         * @param terms the expressions and their reduction operations
+         * @returns the global results in the order of the terms
+         */
+        template <class Comm, class Policy, typename... Terms>
+        auto batchedReduce(Comm& comm, const Policy& policy, const Terms&... terms) {
+            constexpr unsigned Dim = ExtractRank<Policy>::rank;
+            using index_array_type =
+                typename RangePolicy<Dim, typename Policy::execution_space>::index_array_type;
+            using value_type = std::common_type_t<term_value_type<index_array_type, Terms>...>;
+
+            std::array<value_type, sizeof...(Terms)> result = reduceLocal<value_type>(
+                "batchedReduce", policy, std::index_sequence_for<Terms...>{}, terms...);
+            comm.allreduceCustom(result, CombineReductions<value_type, Terms...>{});
+            return result;
+        }
+    }  // namespace detail
+
+    /*!
+     * Functions creating the terms of a batched reduction
+     * @param expr an attribute or field expression
+     */
+#define DefineReductionTerm(name, Op)                                                \
+    template <typename E, size_t N>                                                  \
+    detail::ReductionTerm<Op, E, N> name(const detail::Expression<E, N>& expr) {     \
+        using capture_type = typename detail::ReductionTerm<Op, E, N>::capture_type; \
+        return {reinterpret_cast<const capture_type&>(expr)};                        \
+    }
+
+    DefineReductionTerm(sumOf, ReductionOp::SUM)
+    DefineReductionTerm(maxOf, ReductionOp::MAX)
+    DefineReductionTerm(minOf, ReductionOp::MIN)
+    DefineReductionTerm(prodOf, ReductionOp::PROD)
+}  // namespace ippl
+
+#endif
@@ -29,6 +29,8 @@ void IpplInfo::printHelp(char** argv) {
     std::cout << "   --timer-fences <on|off>     : Enable or disable timer fences (default enabled "
                  "if only "
                  "one accelerator present)\n";
+    std::cout << "   --shared-memory <on|off>    : Exchange halos and particles between ranks on "
+                 "the same node through shared memory (default on)\n";
     std::cout << "   --help                      : Print IPPL help message\n";
     std::cout << "   --kokkos-help               : Print Kokkos help message\n";
 }
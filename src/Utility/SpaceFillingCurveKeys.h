@@ -0,0 +1,162 @@
+//
+// Space-filling curve keys
+//   Hilbert and Morton keys of integer grid coordinates, used by the
+//   space-filling curve partitioner and for ordering particles in memory.
+//
+
+#ifndef IPPL_SPACE_FILLING_CURVE_KEYS_H
+#define IPPL_SPACE_FILLING_CURVE_KEYS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Types/Vector.h"
+
+namespace ippl {
+    enum CurveType {
+        MORTON,
+        HILBERT
+    };
+
+    namespace detail {
+        using sfc_key_type = std::uint64_t;
+
+        /*!
+         * Interleaves the bits of the coordinates into a single key; the most
+         * significant bit of the first coordinate ends up in the most significant
+         * position of the key.
+         * @param x coordinates (modified in place by the Hilbert transform beforehand)
+         * @param bits number of bits per coordinate
+         */
+        template <unsigned Dim>
+        KOKKOS_INLINE_FUNCTION sfc_key_type interleaveBits(const Vector<sfc_key_type, Dim>& x,
+                                                           unsigned bits) {
+            sfc_key_type key = 0;
+            for (int b = bits - 1; b >= 0; --b) {
+                for (unsigned d = 0; d < Dim; ++d) {
+                    key = (key << 1) | ((x[d] >> b) & 1);
+                }
+            }
+            return key;
+        }
+
+        /*!
+         * Morton (Z-order) key of a point on a grid with 2^bits points per dimension
+         * @param x integer coordinates
+         * @param bits number of bits per coordinate
+         */
+        template <unsigned Dim>
+        KOKKOS_INLINE_FUNCTION sfc_key_type mortonKey(const Vector<sfc_key_type, Dim>& x,
+                                                      unsigned bits) {
+            return interleaveBits<Dim>(x, bits);
+        }
+
+        /*!
+         * Position of a point in the Morton order of the points of a box, i.e. the
+         * number of points of the box with a smaller Morton key. Unlike the keys,
+         * the ranks are dense for any box shape: the n points of the box have the
+         * ranks 0 to n - 1.
+         * @param x integer coordinates inside the box
+         * @param length the number of points of the box per dimension, starting at 0
+         * @param bits number of bits per coordinate
+         */
+        template <unsigned Dim>
+        KOKKOS_INLINE_FUNCTION sfc_key_type mortonRank(const Vector<sfc_key_type, Dim>& x,
+                                                       const Vector<sfc_key_type, Dim>& length,
+                                                       unsigned bits) {
+            sfc_key_type rank = 0;
+            for (int b = bits - 1; b >= 0; --b) {
+                for (unsigned d = 0; d < Dim; ++d) {
+                    if (((x[d] >> b) & 1) == 0) {
+                        continue;
+                    }
+                    // Count the points of the box whose key agrees up to this bit
+                    // and has a 0 here. Along the axes up to d, bit b is fixed.
+                    sfc_key_type count = 1;
+                    for (unsigned e = 0; e < Dim && count > 0; ++e) {
+                        const unsigned free     = e <= d ? b : b + 1;
+                        const unsigned fixed    = e == d ? b + 1 : free;
+                        const sfc_key_type base = (x[e] >> fixed) << fixed;
+                        const sfc_key_type n    = sfc_key_type(1) << free;
+                        count *= length[e] > base ? Kokkos::min(length[e] - base, n) : 0;
+                    }
+                    rank += count;
+                }
+            }
+            return rank;
+        }
+
+        /*!
+         * Hilbert key of a point on a grid with 2^bits points per dimension,
+         * computed with Skilling's transpose algorithm (AIP Conf. Proc. 707, 2004).
+         * @param x integer coordinates
+         * @param bits number of bits per coordinate
+         */
+        template <unsigned Dim>
+        KOKKOS_INLINE_FUNCTION sfc_key_type hilbertKey(Vector<sfc_key_type, Dim> x,
+                                                       unsigned bits) {
+            if constexpr (Dim == 1) {
+                return x[0];
+            } else {
+                const sfc_key_type M = sfc_key_type(1) << (bits - 1);
+
+                // Inverse undo
+                for (sfc_key_type Q = M; Q > 1; Q >>= 1) {
+                    const sfc_key_type P = Q - 1;
+                    for (unsigned d = 0; d < Dim; ++d) {
+                        if (x[d] & Q) {
+                            x[0] ^= P;
+                        } else {
+                            sfc_key_type t = (x[0] ^ x[d]) & P;
+                            x[0] ^= t;
+                            x[d] ^= t;
+                        }
+                    }
+                }
+
+                // Gray encode
+                for (unsigned d = 1; d < Dim; ++d) {
+                    x[d] ^= x[d - 1];
+                }
+                sfc_key_type t = 0;
+                for (sfc_key_type Q = M; Q > 1; Q >>= 1) {
+                    if (x[Dim - 1] & Q) {
+                        t ^= Q - 1;
+                    }
+                }
+                for (unsigned d = 0; d < Dim; ++d) {
+                    x[d] ^= t;
+                }
+
+                return interleaveBits<Dim>(x, bits);
+            }
+        }
+
+        /*!
+         * Key of a point along the requested curve
+         * @param curve the curve type
+         * @param x integer coordinates
+         * @param bits number of bits per coordinate
+         */
+        template <unsigned Dim>
+        KOKKOS_INLINE_FUNCTION sfc_key_type curveKey(CurveType curve,
+                                                     const Vector<sfc_key_type, Dim>& x,
+                                                     unsigned bits) {
+            return curve == HILBERT ? hilbertKey<Dim>(x, bits) : mortonKey<Dim>(x, bits);
+        }
+
+        /*!
+         * Smallest number of bits such that 2^bits >= n
+         */
+        inline unsigned bitsFor(std::size_t n) {
+            unsigned bits = 1;
+            while ((std::size_t(1) << bits) < n) {
+                ++bits;
+            }
+            return bits;
+        }
+    }  // namespace detail
+
+}  // namespace ippl
+
+#endif  // IPPL_SPACE_FILLING_CURVE_KEYS_H
@@ -2,6 +2,8 @@
 
 #include <random>
 
+#include "Utility/IpplTimings.h"
+
 template <class PLayout>
 struct Bunch : public ippl::ParticleBase<PLayout> {
     Bunch(PLayout& playout)
@@ -88,20 +90,45 @@ int main(int argc, char* argv[]) {
 
         bunch.update();
 
-        field = 0.0;
+        // Deposit with every scatter backend before and after sorting; the tiled
+        // backend depends most on the particle order
+        auto benchmark = [&](const char* name, auto policy) {
+            IpplTimings::TimerRef timer = IpplTimings::getTimer(name);
 
-        scatter(bunch.Q, field, bunch.R);
+            field = 0.0;
 
-        // Check charge conservation
-        try {
-            double Total_charge_field = field.sum();
+            IpplTimings::startTimer(timer);
+            scatter(bunch.Q, field, bunch.R, policy);
+            IpplTimings::stopTimer(timer);
 
-            std::cout << "Total charge in the field:" << Total_charge_field << std::endl;
-            std::cout << "Total charge of the particles:" << bunch.Q.sum() << std::endl;
-            std::cout << "Error:" << std::fabs(bunch.Q.sum() - Total_charge_field) << std::endl;
-        } catch (const std::exception& e) {
-            std::cout << e.what() << std::endl;
-        }
+            // Check charge conservation
+            try {
+                double Total_charge_field = field.sum();
+
+                std::cout << name << ":" << std::endl;
+                std::cout << "Total charge in the field:" << Total_charge_field << std::endl;
+                std::cout << "Total charge of the particles:" << bunch.Q.sum() << std::endl;
+                std::cout << "Error:" << std::fabs(bunch.Q.sum() - Total_charge_field)
+                          << std::endl;
+            } catch (const std::exception& e) {
+                std::cout << e.what() << std::endl;
+            }
+        };
+
+        // The duplicated field is allocated by the first deposition only
+        ippl::DuplicatedScatter duplicated;
+
+        benchmark("scatterAtomic", ippl::AtomicScatter{});
+        benchmark("scatterDuplicated", duplicated);
+        benchmark("scatterTiled", ippl::TiledScatter{});
+
+        bunch.sort(mesh, layout);
+
+        benchmark("scatterAtomicSorted", ippl::AtomicScatter{});
+        benchmark("scatterDuplicatedSorted", duplicated);
+        benchmark("scatterTiledSorted", ippl::TiledScatter{});
+
+        IpplTimings::print();
     }
     ippl::finalize();
 
@@ -184,6 +184,161 @@ TYPED_TEST(FieldTest, Sum) {
     assertEqual<T>(expected, sum);
 }
 
+TYPED_TEST(FieldTest, BatchedReduce) {
+    using T = typename TestFixture::value_type;
+
+    T val    = 1.5;
+    T nCells = std::reduce(this->nPoints.begin(), this->nPoints.end(), T(1), std::multiplies<>{});
+
+    auto& field = this->field;
+
+    *field = val;
+
+    auto [sum, squares, max, min] =
+        field->reduce(ippl::sumOf(*field), ippl::sumOf(*field * *field), ippl::maxOf(*field),
+                      ippl::minOf(-*field));
+
+    assertEqual<T>(nCells * val, sum);
+    assertEqual<T>(nCells * val * val, squares);
+    assertEqual<T>(val, max);
+    assertEqual<T>(-val, min);
+}
+
+TYPED_TEST(FieldTest, Redistribute) {
+    using T                = typename TestFixture::value_type;
+    constexpr unsigned Dim = TestFixture::dim;
+    using fv_type          = FieldVal<TypeParam>;
+
+    auto& field  = this->field;
+    auto& layout = this->layout;
+
+    // The values only depend on the global index
+    const ippl::Vector<T, Dim> dx = field->get_mesh().getMeshSpacing();
+    auto setValues = [&](typename TestFixture::field_type& f) {
+        fv_type fv(f.getView(), f.getOwned(), dx);
+        auto policy = f.template getFieldRangePolicy<typename fv_type::Norm>();
+        Kokkos::parallel_for("Set field", policy, fv);
+    };
+    setValues(*field);
+
+    // Hand the local domains to the ranks in reverse order
+    const int nRanks         = ippl::Comm->size();
+    const auto& localDomains = layout->getHostLocalDomains();
+    std::vector<ippl::NDIndex<Dim>> domains(nRanks);
+    for (int rank = 0; rank < nRanks; ++rank) {
+        domains[rank] = localDomains(nRanks - 1 - rank);
+    }
+    layout->updateLayout(domains);
+    ippl::redistribute(*layout, *field);
+
+    typename TestFixture::field_type expected(*this->mesh, *layout);
+    setValues(expected);
+
+    auto mirror         = field->getHostMirror();
+    auto expectedMirror = expected.getHostMirror();
+    Kokkos::deep_copy(mirror, field->getView());
+    Kokkos::deep_copy(expectedMirror, expected.getView());
+
+    nestedViewLoop(mirror, field->getNghost(), [&]<typename... Idx>(const Idx... args) {
+        assertEqual<T>(expectedMirror(args...), mirror(args...));
+    });
+}
+
+TYPED_TEST(FieldTest, PartitionStrategies) {
+    using T                = typename TestFixture::value_type;
+    constexpr unsigned Dim = TestFixture::dim;
+
+    const ippl::NDIndex<Dim>& domain = this->layout->getDomain();
+    T nCells = std::reduce(this->nPoints.begin(), this->nPoints.end(), T(1), std::multiplies<>{});
+
+    std::array<bool, Dim> isParallel;
+    isParallel.fill(true);
+
+    for (auto strategy : {ippl::PartitionStrategy::MIN_SURFACE, ippl::PartitionStrategy::PENCIL,
+                          ippl::PartitionStrategy::SLAB}) {
+        typename TestFixture::layout_type layout(MPI_COMM_WORLD, domain, isParallel, false,
+                                                 strategy);
+        typename TestFixture::field_type field(*this->mesh, layout);
+
+        // The subdomains tile the domain
+        field = 1.0;
+        assertEqual<T>(nCells, field.sum());
+
+        if (strategy == ippl::PartitionStrategy::SLAB) {
+            unsigned splitAxes = 0;
+            for (unsigned d = 0; d < Dim; d++) {
+                splitAxes += layout.getLocalNDIndex()[d].length() < domain[d].length();
+            }
+            ASSERT_LE(splitAxes, 1u);
+        }
+    }
+}
+
+TYPED_TEST(FieldTest, RankCapacities) {
+    using T                = typename TestFixture::value_type;
+    constexpr unsigned Dim = TestFixture::dim;
+
+    const ippl::NDIndex<Dim>& domain = this->layout->getDomain();
+    T nCells = std::reduce(this->nPoints.begin(), this->nPoints.end(), T(1), std::multiplies<>{});
+
+    std::array<bool, Dim> isParallel;
+    isParallel.fill(true);
+
+    // The first rank is three times as fast as the others
+    const int nRanks = ippl::Comm->size();
+    std::vector<double> capacities(nRanks, 1.0);
+    capacities[0] = 3.0;
+
+    typename TestFixture::layout_type layout(MPI_COMM_WORLD, domain, isParallel, false,
+                                             ippl::PartitionStrategy::BISECTION, 1, capacities);
+    typename TestFixture::field_type field(*this->mesh, layout);
+
+    // The subdomains tile the domain
+    field = 1.0;
+    assertEqual<T>(nCells, field.sum());
+
+    if (nRanks > 1) {
+        const auto& domains = layout.getHostLocalDomains();
+        ASSERT_GT(domains(0).size(), domains(1).size());
+    }
+}
+
+TYPED_TEST(FieldTest, NodeAwarePartition) {
+    using T                = typename TestFixture::value_type;
+    constexpr unsigned Dim = TestFixture::dim;
+
+    const ippl::NDIndex<Dim>& domain = this->layout->getDomain();
+    T nCells = std::reduce(this->nPoints.begin(), this->nPoints.end(), T(1), std::multiplies<>{});
+
+    std::array<bool, Dim> isParallel;
+    isParallel.fill(true);
+
+    typename TestFixture::layout_type layout(MPI_COMM_WORLD, domain, isParallel, false,
+                                             ippl::PartitionStrategy::MIN_SURFACE, 1, {}, true);
+    typename TestFixture::field_type field(*this->mesh, layout);
+
+    // The subdomains tile the domain
+    field = 1.0;
+    assertEqual<T>(nCells, field.sum());
+
+    // The ranks of a node own a box: their subdomains fill their bounding box
+    const std::vector<int> nodeIds = ippl::Comm->nodeIds();
+    const auto& domains            = layout.getHostLocalDomains();
+    ippl::NDIndex<Dim> box         = domains(ippl::Comm->rank());
+    size_t nodeCells               = 0;
+    for (size_t rank = 0; rank < domains.extent(0); ++rank) {
+        if (nodeIds[rank] != nodeIds[ippl::Comm->rank()]) {
+            continue;
+        }
+        nodeCells += domains(rank).size();
+        for (unsigned d = 0; d < Dim; d++) {
+            box[d] = ippl::Index(std::min(box[d].first(), domains(rank)[d].first()),
+                                 std::max(box[d].last(), domains(rank)[d].last()));
+        }
+    }
+    ASSERT_EQ(nodeCells, box.size());
+}
+
 TYPED_TEST(FieldTest, Norm1) {
     using T = typename TestFixture::value_type;
 
@@ -136,6 +136,31 @@ TYPED_TEST(HaloTest, CheckCubes) {
     }
 }
 
+TYPED_TEST(HaloTest, DomainTree) {
+    constexpr unsigned Dim = TestFixture::dim;
+
+    const auto& domains = this->layout.getHostLocalDomains();
+    const auto& tree    = this->layout.getDomainTree();
+
+    // The tree finds the same ranks as testing every domain
+    for (int nghost = 1; nghost < 3; nghost++) {
+        for (size_t rank = 0; rank < domains.extent(0); ++rank) {
+            ippl::NDIndex<Dim> box = domains(rank).grow(nghost);
+
+            std::vector<int> expected;
+            for (size_t other = 0; other < domains.extent(0); ++other) {
+                if (box.touches(domains(other))) {
+                    expected.push_back(other);
+                }
+            }
+
+            std::vector<int> found;
+            tree.findTouching(box, found);
+            ASSERT_EQ(expected, found);
+        }
+    }
+}
+
 TYPED_TEST(HaloTest, FillHalo) {
     auto& field = this->field;
 
@@ -148,6 +173,27 @@ TYPED_TEST(HaloTest, FillHalo) {
     });
 }
 
+TYPED_TEST(HaloTest, SharedMemory) {
+    using T = typename TestFixture::value_type;
+
+    auto& field = this->field;
+
+    // Neighbors on the same node receive the same halo through shared memory
+    // as through MPI
+    auto fill = [&](bool sharedMemory) {
+        ippl::mpi::Communicator::enableSharedMemory = sharedMemory;
+        *field                                      = ippl::Comm->rank() + 1;
+        field->fillHalo();
+        return Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), field->getView());
+    };
+    auto expected = fill(false);
+    auto view     = fill(true);
+
+    nestedViewLoop(view, 0, [&]<typename... Idx>(const Idx... args) {
+        assertEqual<T>(view(args...), expected(args...));
+    });
+}
+
 TYPED_TEST(HaloTest, AccumulateHalo) {
     constexpr unsigned Dim = TestFixture::dim;
 
@@ -167,6 +167,111 @@ TYPED_TEST(ORBTest, Charge) {
                 tolerance<typename TestFixture::value_type>);
 }
 
+TYPED_TEST(ORBTest, Profile) {
+    constexpr unsigned Dim = TestFixture::dim;
+
+    auto& orb = this->orb;
+    orb.bf_m  = 1.0;
+
+    // Both halves of the domain, cut along the first and the last axis
+    ippl::NDIndex<Dim> left, right;
+    ippl::NDIndex<Dim> dom = this->layout.getDomain();
+    const int cut          = dom[0].first() + dom[0].length() / 2 - 1;
+    dom.split(left, right, 0, cut);
+
+    std::vector<ippl::NDIndex<Dim>> doms = {left, right};
+    std::vector<unsigned int> cutAxes    = {0, Dim - 1};
+
+    std::vector<double> local, profiles;
+    orb.perpendicularReduction(local, cutAxes, doms);
+    profiles.resize(local.size());
+    ippl::Comm->allreduce(local.data(), profiles.data(), local.size(), std::plus<double>());
+
+    size_t entry = 0;
+    for (size_t k = 0; k < doms.size(); ++k) {
+        const double planeSize = doms[k].size() / doms[k][cutAxes[k]].length();
+        for (size_t i = 0; i < doms[k][cutAxes[k]].length(); ++i) {
+            ASSERT_DOUBLE_EQ(profiles[entry++], planeSize);
+        }
+    }
+    ASSERT_EQ(entry, profiles.size());
+}
+
+TYPED_TEST(ORBTest, Incremental) {
+    constexpr unsigned Dim = TestFixture::dim;
+
+    auto& bunch  = this->bunch;
+    auto& layout = this->layout;
+
+    bunch->update();
+    this->repartition();
+    bunch->update();
+
+    const ippl::NDIndex<Dim> previous = layout.getLocalNDIndex();
+
+    // Without any shift the cuts of the previous repartition are kept
+    ASSERT_TRUE(this->orb.incrementalRepartition(bunch->R, layout, 0));
+    for (unsigned d = 0; d < Dim; d++) {
+        ASSERT_EQ(layout.getLocalNDIndex()[d], previous[d]);
+    }
+}
+
+TYPED_TEST(ORBTest, WeightedMedian) {
+    // The cut leaves the requested fraction of a uniform profile on the left
+    std::vector<double> profile(32, 1.0);
+    for (double fraction : {0.25, 0.5, 0.75}) {
+        const int median = this->orb.findMedian(profile, fraction);
+        ASSERT_NEAR(median + 1, fraction * profile.size(), 1);
+    }
+}
+
+TYPED_TEST(ORBTest, CellWeight) {
+    auto& bunch = this->bunch;
+    auto& orb   = this->orb;
+
+    bunch->update();
+
+    // Every particle deposits its weight and every owned cell adds its own
+    const double particleWeight = 2.0, cellWeight = 0.5;
+    orb.setCostWeights(particleWeight, cellWeight);
+    orb.scatterR(bunch->R);
+
+    const double expected =
+        particleWeight * this->nParticles + cellWeight * this->layout.getDomain().size();
+    ASSERT_NEAR((orb.bf_m.sum() - expected) / expected, 0.,
+                tolerance<typename TestFixture::value_type>);
+}
+
+TYPED_TEST(ORBTest, CostModel) {
+    const int rank   = ippl::Comm->rank();
+    const int nRanks = ippl::Comm->size();
+
+    ippl::CostModel cost({"costModelParticles"}, {"costModelCells"});
+
+    // Rank r spends r + 1 seconds on 10 particles and 2 seconds on 100 cells
+    IpplTimings::infoTimer("costModelParticles")->wallTime += rank + 1;
+    IpplTimings::infoTimer("costModelCells")->wallTime += 2;
+    cost.measure(10, 100);
+
+    const double particleTime = nRanks * (nRanks + 1) / 2.;
+    EXPECT_DOUBLE_EQ(cost.particleCost(), particleTime / (10. * nRanks));
+    EXPECT_DOUBLE_EQ(cost.cellCost(), 2. / 100);
+
+    const double meanTime = particleTime / nRanks + 2;
+    EXPECT_DOUBLE_EQ(cost.imbalance(), (nRanks + 2) / meanTime);
+
+    // All ranks have the same work, so the capacity is inversely proportional to the time
+    const auto& capacities = cost.capacities();
+    ASSERT_EQ(capacities.size(), size_t(nRanks));
+    for (int r = 0; r < nRanks; ++r) {
+        EXPECT_DOUBLE_EQ(capacities[r], meanTime / (r + 3));
+    }
+
+    // Only the time since the last measurement counts
+    cost.measure(10, 100);
+    EXPECT_DOUBLE_EQ(cost.imbalance(), 1);
+}
+
 int main(int argc, char* argv[]) {
     int success = 1;
     ippl::initialize(argc, argv);
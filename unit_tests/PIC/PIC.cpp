@@ -4,6 +4,7 @@
 //
 #include "Ippl.h"
 
+#include <algorithm>
 #include <random>
 
 #include "TestUtils.h"
@@ -29,11 +30,13 @@ public:
         explicit Bunch(PLayout& playout)
             : ippl::ParticleBase<PLayout>(playout) {
             this->addAttribute(Q);
+            this->addAttribute(P);
         }
 
         ~Bunch() = default;
 
         ippl::ParticleAttrib<double, ExecSpace> Q;
+        ippl::ParticleAttrib<ippl::Vector<T, Dim>, ExecSpace> P;
     };
 
     using bunch_type = Bunch<playout_type>;
@@ -131,6 +134,46 @@ TYPED_TEST(PICTest, Scatter) {
                 tolerance<typename TestFixture::value_type>);
 }
 
+TYPED_TEST(PICTest, ScatterPolicies) {
+    auto& field      = this->field;
+    auto& bunch      = this->bunch;
+    auto& nParticles = this->nParticles;
+
+    double charge = 0.5;
+
+    bunch->Q = charge;
+
+    bunch->update();
+    bunch->sort(this->mesh, this->layout);
+
+    *field = 0.0;
+    scatter(bunch->Q, *field, bunch->R, ippl::AtomicScatter{});
+    ASSERT_NEAR((nParticles * charge - field->sum()) / (nParticles * charge), 0.0,
+                tolerance<typename TestFixture::value_type>);
+
+    auto reference = field->getHostMirror();
+    Kokkos::deep_copy(reference, field->getView());
+
+    // Every backend must deposit the same charge into every cell as the atomic one
+    auto compare = [&]<typename Policy>(Policy policy) {
+        *field = 0.0;
+        scatter(bunch->Q, *field, bunch->R, policy);
+
+        auto mirror = field->getHostMirror();
+        Kokkos::deep_copy(mirror, field->getView());
+        nestedViewLoop(mirror, field->getNghost(), [&]<typename... Idx>(const Idx... args) {
+            ASSERT_NEAR(reference(args...), mirror(args...),
+                        charge * tolerance<typename TestFixture::value_type>);
+        });
+    };
+
+    // The second deposition reuses the duplicated field of the first
+    ippl::DuplicatedScatter duplicated;
+    compare(duplicated);
+    compare(duplicated);
+    compare(ippl::TiledScatter{});
+}
+
 TYPED_TEST(PICTest, Gather) {
     auto& field      = this->field;
     auto& bunch      = this->bunch;
@@ -147,6 +190,214 @@ TYPED_TEST(PICTest, Gather) {
     ASSERT_DOUBLE_EQ((nParticles - bunch->Q.sum()) / nParticles, 0.0);
 }
 
+TYPED_TEST(PICTest, ShapeFunctions) {
+    using T                = typename TestFixture::value_type;
+    constexpr unsigned Dim = TestFixture::dim;
+    using field_type       = typename TestFixture::field_type;
+    using playout_type     = typename TestFixture::playout_type;
+    using bunch_type       = typename TestFixture::bunch_type;
+
+    auto& bunch      = this->bunch;
+    auto& nParticles = this->nParticles;
+
+    // Wide stencils reach past the domain boundary, so deposit on a periodic
+    // layout with enough ghost layers for PQS
+    std::array<bool, Dim> isParallel;
+    isParallel.fill(true);
+    typename TestFixture::flayout_type layout(MPI_COMM_WORLD, this->layout.getDomain(), isParallel,
+                                              true);
+    field_type field(this->mesh, layout, ippl::PQS::ghostCells);
+
+    // A single particle 0.3 cells above the lower corner of the domain, whose
+    // stencil reaches into the ghost cells and wraps around to the upper end
+    playout_type playout(layout, this->mesh);
+    bunch_type single(playout);
+    single.create(ippl::Comm->rank() == 0 ? 1 : 0);
+    auto R_host = single.R.getHostMirror();
+    Kokkos::deep_copy(R_host, single.R.getView());
+    const auto& hx = this->mesh.getMeshSpacing();
+    for (size_t i = 0; i < single.getLocalNum(); ++i) {
+        for (unsigned d = 0; d < Dim; d++) {
+            R_host(i)[d] = 0.3 * hx[d];
+        }
+    }
+    Kokkos::deep_copy(single.R.getView(), R_host);
+    single.Q = 1.0;
+    single.update();
+
+    double charge = 0.5;
+
+    bunch->Q = charge;
+
+    bunch->update();
+
+    const ippl::NDIndex<Dim>& lDom = layout.getLocalNDIndex();
+    const int nghost               = field.getNghost();
+
+    // Checks the deposit of the single particle against the first stencil cell and
+    // the weights of the stencil points along every axis
+    auto check = [&]<typename Shape>(int first, const std::vector<double>& weights) {
+        ASSERT_EQ(weights.size(), Shape::width);
+
+        // The weights of a global cell along one axis, including the periodic images
+        auto weight = [&](unsigned d, int cell) {
+            const int n = this->nPoints[d];
+            double w    = 0;
+            for (unsigned k = 0; k < Shape::width; ++k) {
+                if (((first + int(k)) % n + n) % n == cell) {
+                    w += weights[k];
+                }
+            }
+            return w;
+        };
+
+        field = 0.0;
+        scatter<Shape>(single.Q, field, single.R);
+
+        auto mirror = field.getHostMirror();
+        Kokkos::deep_copy(mirror, field.getView());
+        nestedViewLoop(mirror, nghost, [&]<typename... Idx>(const Idx... args) {
+            const std::array<int, Dim> index = {int(args)...};
+            double expected                  = 1;
+            for (unsigned d = 0; d < Dim; d++) {
+                expected *= weight(d, index[d] - nghost + lDom[d].first());
+            }
+            ASSERT_NEAR(mirror(args...), expected, tolerance<T>);
+        });
+
+        // The weights of every shape sum to one, so the charge is conserved...
+        field = 0.0;
+        scatter<Shape>(bunch->Q, field, bunch->R);
+        ASSERT_NEAR((nParticles * charge - field.sum()) / (nParticles * charge), 0.0,
+                    tolerance<T>);
+
+        // ...and a constant field is interpolated exactly
+        field = 1.0;
+        gather<Shape>(bunch->Q, field, bunch->R);
+        ASSERT_NEAR((nParticles - bunch->Q.sum()) / nParticles, 0.0, tolerance<T>);
+    };
+
+    // B-spline weights of a particle 0.8 cells right of the first point (odd
+    // orders) or 0.2 cells left of the nearest point (even orders)
+    check.template operator()<ippl::NGP>(0, {1});
+    check.template operator()<ippl::CIC>(-1, {0.2, 0.8});
+    check.template operator()<ippl::TSC>(-1, {0.245, 0.71, 0.045});
+    check.template operator()<ippl::PQS>(-2, {0.008 / 6, 1.696 / 6, 3.784 / 6, 0.512 / 6});
+}
+
+TYPED_TEST(PICTest, FusedPush) {
+    using T                = typename TestFixture::value_type;
+    constexpr unsigned Dim = TestFixture::dim;
+    using vfield_type =
+        ippl::Field<ippl::Vector<double, Dim>, Dim, typename TestFixture::mesh_type,
+                    typename TestFixture::centering_type,
+                    typename TestFixture::field_type::execution_space>;
+
+    auto& bunch = this->bunch;
+
+    vfield_type E(this->mesh, this->layout);
+    E = ippl::Vector<double, Dim>(1.0);
+
+    bunch->P = ippl::Vector<T, Dim>(T(0));
+    bunch->setParticleBC(ippl::BC::PERIODIC);
+
+    const T kick  = 0.25;
+    const T drift = 2.0;
+
+    // The particles pick up the kick from the constant field, drift by
+    // kick * drift along every axis and are wrapped back into the domain
+    auto R_host = bunch->R.getHostMirror();
+    Kokkos::deep_copy(R_host, bunch->R.getView());
+    std::vector<ippl::Vector<T, Dim>> expected(bunch->getLocalNum());
+    for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+        for (unsigned d = 0; d < Dim; d++) {
+            T x            = R_host(i)[d] + kick * drift;
+            expected[i][d] = x >= this->domain[d] ? x - this->domain[d] : x;
+        }
+    }
+
+    ippl::pushParticles(ippl::LeapFrogPusher<T, Dim>{kick, drift}, E, *bunch, bunch->P);
+
+    auto P_host = bunch->P.getHostMirror();
+    Kokkos::deep_copy(P_host, bunch->P.getView());
+    Kokkos::deep_copy(R_host, bunch->R.getView());
+    for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+        for (unsigned d = 0; d < Dim; d++) {
+            ASSERT_NEAR(P_host(i)[d], kick, tolerance<T>);
+            ASSERT_NEAR(R_host(i)[d], expected[i][d], tolerance<T>);
+        }
+    }
+
+    // A kick only leaves the positions untouched
+    ippl::pushParticles(ippl::LeapFrogPusher<T, Dim>{kick, 0}, E, *bunch, bunch->P);
+
+    Kokkos::deep_copy(P_host, bunch->P.getView());
+    for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+        for (unsigned d = 0; d < Dim; d++) {
+            ASSERT_NEAR(P_host(i)[d], 2 * kick, tolerance<T>);
+        }
+    }
+}
+
+TYPED_TEST(PICTest, FusedPushSink) {
+    using T                = typename TestFixture::value_type;
+    constexpr unsigned Dim = TestFixture::dim;
+    using vfield_type =
+        ippl::Field<ippl::Vector<double, Dim>, Dim, typename TestFixture::mesh_type,
+                    typename TestFixture::centering_type,
+                    typename TestFixture::field_type::execution_space>;
+
+    auto& bunch = this->bunch;
+
+    bunch->update();
+
+    vfield_type E(this->mesh, this->layout);
+    E = ippl::Vector<double, Dim>(1.0);
+
+    bunch->P = ippl::Vector<T, Dim>(T(0));
+    bunch->setParticleBC(ippl::BC::SINK);
+    bunch->getLayout().setSinkAbsorbing(true);
+
+    // The particles move by a quarter of the shortest side along every axis;
+    // those that cross an upper face are absorbed by the push itself
+    T shortest = this->domain[0];
+    for (unsigned d = 1; d < Dim; d++) {
+        shortest = std::min<T>(shortest, this->domain[d]);
+    }
+    const T kick  = 0.5;
+    const T drift = shortest / 2;
+
+    auto R_host = bunch->R.getHostMirror();
+    Kokkos::deep_copy(R_host, bunch->R.getView());
+    const size_t nLocal = bunch->getLocalNum();
+    size_t survivors = 0;
+    for (size_t i = 0; i < nLocal; ++i) {
+        bool inside = true;
+        for (unsigned d = 0; d < Dim; d++) {
+            inside &= R_host(i)[d] + kick * drift < this->domain[d];
+        }
+        survivors += inside;
+    }
+
+    ippl::pushParticles(ippl::LeapFrogPusher<T, Dim>{kick, drift}, E, *bunch, bunch->P);
+    ASSERT_EQ(bunch->getLocalNum(), survivors);
+    EXPECT_EQ(bunch->isTotalNumStale(), survivors < nLocal);
+
+    bunch->update(false);
+
+    size_t expected = survivors, total = bunch->getLocalNum();
+    ippl::Comm->allreduce(expected, 1, std::plus<size_t>());
+    ippl::Comm->allreduce(total, 1, std::plus<size_t>());
+    ASSERT_EQ(total, expected);
+    ASSERT_LT(total, this->nParticles);
+
+    // Absorption is local; the total is only recounted on request
+    bunch->updateTotalNum();
+    EXPECT_EQ(bunch->getTotalNum(), expected);
+
+    bunch->getLayout().setSinkAbsorbing(false);
+}
+
 int main(int argc, char* argv[]) {
     int success = 1;
     ippl::initialize(argc, argv);
@@ -0,0 +1,251 @@
+//
+// Unit tests SFC for class SpaceFillingCurve
+//   Test curve keys, load balance and owned bricks of the SFC partitioner.
+//
+//
+#include "Ippl.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+
+#include "TestUtils.h"
+#include "gtest/gtest.h"
+
+template <typename>
+class SFCTest;
+
+template <typename T, typename ExecSpace, unsigned Dim>
+class SFCTest<Parameters<T, ExecSpace, Rank<Dim>>> : public ::testing::Test {
+public:
+    constexpr static unsigned dim = Dim;
+    using value_type              = T;
+
+    using mesh_type      = ippl::UniformCartesian<double, Dim>;
+    using centering_type = typename mesh_type::DefaultCentering;
+    using field_type     = ippl::Field<double, Dim, mesh_type, centering_type, ExecSpace>;
+    using flayout_type   = ippl::FieldLayout<Dim>;
+    using playout_type   = ippl::ParticleSpatialLayout<T, Dim, mesh_type, ExecSpace>;
+    using SFC            = ippl::SpaceFillingCurve<field_type>;
+    using bunch_type     = ippl::ParticleBase<playout_type>;
+
+    SFCTest()
+        : nPoints(getGridSizes<Dim>()) {
+        for (unsigned d = 0; d < Dim; d++) {
+            domain[d] = nPoints[d] / 32.;
+        }
+
+        std::array<ippl::Index, Dim> args;
+        for (unsigned d = 0; d < Dim; d++)
+            args[d] = ippl::Index(nPoints[d]);
+        auto owned = std::make_from_tuple<ippl::NDIndex<Dim>>(args);
+
+        ippl::Vector<double, Dim> hx;
+        ippl::Vector<double, Dim> origin;
+
+        std::array<bool, Dim> isParallel;
+        isParallel.fill(true);
+
+        for (unsigned int d = 0; d < Dim; d++) {
+            hx[d]     = domain[d] / nPoints[d];
+            origin[d] = 0;
+        }
+
+        layout  = flayout_type(MPI_COMM_WORLD, owned, isParallel, true);
+        mesh    = mesh_type(owned, hx, origin);
+        field   = std::make_shared<field_type>(mesh, layout);
+        playout = playout_type(layout, mesh);
+        bunch   = std::make_shared<bunch_type>(playout);
+
+        size_t nloc = nParticles / ippl::Comm->size();
+        bunch->create(nloc);
+
+        // Cluster the particles in one corner of the domain
+        std::mt19937_64 eng;
+        eng.seed(42);
+        eng.discard(nloc * ippl::Comm->rank());
+        std::uniform_real_distribution<double> unif(0, 1);
+
+        auto R_host = bunch->R.getHostMirror();
+        for (size_t i = 0; i < nloc; ++i) {
+            for (unsigned d = 0; d < Dim; d++) {
+                R_host(i)[d] = unif(eng) * unif(eng) * domain[d];
+            }
+        }
+
+        Kokkos::deep_copy(bunch->R.getView(), R_host);
+        // The scatter only covers the local domain and its ghost cells
+        bunch->update();
+
+        sfc.initialize(layout, mesh, *field);
+    }
+
+    std::shared_ptr<field_type> field;
+    std::shared_ptr<bunch_type> bunch;
+    size_t nParticles = 1024;
+    std::array<size_t, Dim> nPoints;
+    std::array<double, Dim> domain;
+
+    flayout_type layout;
+    mesh_type mesh;
+    playout_type playout;
+    SFC sfc;
+};
+
+using Tests = TestParams::tests<1, 2, 3, 4, 5, 6>;
+TYPED_TEST_CASE(SFCTest, Tests);
+
+TYPED_TEST(SFCTest, HilbertAdjacency) {
+    constexpr unsigned Dim = TestFixture::dim;
+    using key_type         = ippl::detail::sfc_key_type;
+
+    const unsigned bits = 2;
+    const key_type n    = key_type(1) << bits;
+    key_type nTotal     = 1;
+    for (unsigned d = 0; d < Dim; d++) {
+        nTotal *= n;
+    }
+
+    // The keys are a permutation and consecutive keys belong to neighbouring points
+    std::vector<ippl::Vector<key_type, Dim>> points(nTotal);
+    std::set<key_type> keys;
+    for (key_type i = 0; i < nTotal; i++) {
+        key_type rem = i;
+        ippl::Vector<key_type, Dim> x;
+        for (unsigned d = 0; d < Dim; d++) {
+            x[d] = rem % n;
+            rem /= n;
+        }
+        key_type key = ippl::detail::hilbertKey<Dim>(x, bits);
+        ASSERT_LT(key, nTotal);
+        keys.insert(key);
+        points[key] = x;
+    }
+    ASSERT_EQ(keys.size(), nTotal);
+
+    for (key_type k = 1; k < nTotal; k++) {
+        key_type dist = 0;
+        for (unsigned d = 0; d < Dim; d++) {
+            dist += points[k][d] > points[k - 1][d] ? points[k][d] - points[k - 1][d]
+                                                    : points[k - 1][d] - points[k][d];
+        }
+        ASSERT_EQ(dist, 1u);
+    }
+}
+
+TYPED_TEST(SFCTest, MortonRank) {
+    constexpr unsigned Dim = TestFixture::dim;
+    using key_type         = ippl::detail::sfc_key_type;
+
+    // An anisotropic box whose sides are no powers of two
+    ippl::Vector<key_type, Dim> length;
+    key_type nTotal = 1, maxLength = 0;
+    for (unsigned d = 0; d < Dim; d++) {
+        length[d] = d + 2;
+        nTotal *= length[d];
+        maxLength = std::max(maxLength, length[d]);
+    }
+    const unsigned bits = ippl::detail::bitsFor(maxLength);
+
+    // The ranks number the points of the box densely in the order of their keys
+    std::map<key_type, key_type> ranks;
+    for (key_type i = 0; i < nTotal; i++) {
+        key_type rem = i;
+        ippl::Vector<key_type, Dim> x;
+        for (unsigned d = 0; d < Dim; d++) {
+            x[d] = rem % length[d];
+            rem /= length[d];
+        }
+        const key_type key = ippl::detail::mortonKey<Dim>(x, bits);
+        ranks[key]         = ippl::detail::mortonRank<Dim>(x, length, bits);
+    }
+    ASSERT_EQ(ranks.size(), nTotal);
+
+    key_type expected = 0;
+    for (const auto& [key, rank] : ranks) {
+        ASSERT_EQ(rank, expected++);
+    }
+}
+
+TYPED_TEST(SFCTest, Balance) {
+    auto& sfc = this->sfc;
+
+    this->sfc.repartition(this->bunch->R, false);
+
+    const auto& weights = sfc.getBrickWeights();
+    const auto& owners  = sfc.getBrickOwners();
+    const int nRanks    = ippl::Comm->size();
+
+    std::vector<double> rankWeights(nRanks, 0.0);
+    double maxBrick = 0;
+    for (size_t b = 0; b < weights.size(); b++) {
+        rankWeights[owners[b]] += weights[b];
+        maxBrick = std::max(maxBrick, weights[b]);
+    }
+
+    double total = std::accumulate(rankWeights.begin(), rankWeights.end(), 0.0);
+    ASSERT_NEAR((total - this->nParticles) / total, 0.,
+                tolerance<typename TestFixture::value_type>);
+
+    // The midpoint rule misplaces at most one brick at each end of a chunk
+    for (int r = 0; r < nRanks; r++) {
+        ASSERT_LE(std::fabs(rankWeights[r] - total / nRanks), maxBrick);
+    }
+}
+
+TYPED_TEST(SFCTest, OwnedBricks) {
+    constexpr unsigned Dim = TestFixture::dim;
+
+    auto& sfc = this->sfc;
+
+    sfc.repartition(this->bunch->R, false);
+
+    // The bricks of all ranks cover every cell of the domain exactly once
+    const auto& owners = sfc.getBrickOwners();
+    const int nRanks   = ippl::Comm->size();
+
+    size_t nBricks = 0, nCells = 0;
+    double volume = 0;
+    for (int r = 0; r < nRanks; r++) {
+        const auto bricks  = sfc.getOwnedBricks(r);
+        const auto regions = sfc.getOwnedRegions(r);
+        ASSERT_EQ(bricks.size(), size_t(std::count(owners.begin(), owners.end(), r)));
+        ASSERT_EQ(regions.size(), bricks.size());
+
+        nBricks += bricks.size();
+        for (const auto& brick : bricks) {
+            nCells += brick.size();
+        }
+        for (const auto& region : regions) {
+            double v = 1;
+            for (unsigned d = 0; d < Dim; d++) {
+                v *= region[d].length();
+            }
+            volume += v;
+        }
+    }
+
+    size_t nTotal      = 1;
+    double totalVolume = 1;
+    for (unsigned d = 0; d < Dim; d++) {
+        nTotal *= this->nPoints[d];
+        totalVolume *= this->domain[d];
+    }
+    ASSERT_EQ(nBricks, owners.size());
+    ASSERT_EQ(nCells, nTotal);
+    ASSERT_NEAR((volume - totalVolume) / totalVolume, 0.,
+                tolerance<typename TestFixture::value_type>);
+}
+
+int main(int argc, char* argv[]) {
+    int success = 1;
+    ippl::initialize(argc, argv);
+    {
+        ::testing::InitGoogleTest(&argc, argv);
+        success = RUN_ALL_TESTS();
+    }
+    ippl::finalize();
+    return success;
+}
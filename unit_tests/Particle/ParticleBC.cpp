@@ -217,6 +217,88 @@ TYPED_TEST(ParticleBCTest, LowerSinkBC) {
     this->checkResult(expected);
 }
 
+TYPED_TEST(ParticleBCTest, SinkMask) {
+    using T                = typename TestFixture::value_type;
+    constexpr unsigned Dim = TestFixture::dim;
+    using bool_type        = typename TestFixture::playout_type::bool_type;
+
+    auto& bunch = this->bunch;
+    auto& nr    = this->nr;
+
+    // Sink on both x-faces, periodic elsewhere
+    const ippl::Vector<T, Dim>& pos = this->len + this->shift;
+    this->setup(pos);
+
+    typename TestFixture::playout_type::bc_container_type bcs;
+    bcs.fill(ippl::BC::PERIODIC);
+    bcs[0] = ippl::BC::SINK;
+    bcs[1] = ippl::BC::SINK;
+    bunch->setParticleBC(bcs);
+
+    bool_type sunk("sunk", this->nParticles);
+    auto count = bunch->getLayout().applyBC(bunch->R, nr, sunk);
+    EXPECT_EQ(count, size_t(this->nParticles));
+
+    auto sunk_host = Kokkos::create_mirror_view(sunk);
+    Kokkos::deep_copy(sunk_host, sunk);
+    for (int i = 0; i < this->nParticles; ++i) {
+        EXPECT_TRUE(sunk_host(i));
+    }
+
+    ippl::Vector<T, Dim> expected = this->shift;
+    expected[0]                   = this->len[0];
+    this->checkResult(expected);
+}
+
+TYPED_TEST(ParticleBCTest, SinkMaskMixed) {
+    using T                = typename TestFixture::value_type;
+    constexpr unsigned Dim = TestFixture::dim;
+    using bool_type        = typename TestFixture::playout_type::bool_type;
+
+    auto& bunch  = this->bunch;
+    auto& nr     = this->nr;
+    auto& mirror = this->mirror;
+
+    // Every third particle leaves through the upper x-face, the others stay inside
+    const ippl::Vector<T, Dim>& outside = this->len + this->shift;
+    ippl::Vector<T, Dim> inside;
+    for (unsigned d = 0; d < Dim; d++) {
+        inside[d] = this->len[d] / 2;
+    }
+    this->setup(inside);
+    for (int i = 0; i < this->nParticles; i += 3) {
+        mirror(i) = outside;
+    }
+    Kokkos::deep_copy(bunch->R.getView(), mirror);
+
+    typename TestFixture::playout_type::bc_container_type bcs;
+    bcs.fill(ippl::BC::PERIODIC);
+    bcs[0] = ippl::BC::SINK;
+    bcs[1] = ippl::BC::SINK;
+    bunch->setParticleBC(bcs);
+
+    bool_type sunk("sunk", this->nParticles);
+    auto count = bunch->getLayout().applyBC(bunch->R, nr, sunk);
+    EXPECT_EQ(count, size_t((this->nParticles + 2) / 3));
+
+    auto sunk_host = Kokkos::create_mirror_view(sunk);
+    Kokkos::deep_copy(sunk_host, sunk);
+    Kokkos::deep_copy(mirror, bunch->R.getView());
+    for (int i = 0; i < this->nParticles; ++i) {
+        const bool out = i % 3 == 0;
+        EXPECT_EQ(sunk_host(i), out);
+
+        ippl::Vector<T, Dim> expected = inside;
+        if (out) {
+            expected    = this->shift;
+            expected[0] = this->len[0];
+        }
+        for (unsigned d = 0; d < Dim; ++d) {
+            ASSERT_NEAR(expected[d], mirror(i)[d], tolerance<T> / 10);
+        }
+    }
+}
+
 int main(int argc, char* argv[]) {
     int success = 1;
     ippl::initialize(argc, argv);
@@ -4,6 +4,9 @@
 //
 #include "Ippl.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "Particle/ParticleAttrib.h"
 #include "TestUtils.h"
 #include "gtest/gtest.h"
@@ -21,6 +24,7 @@ template <typename T, typename IDSpace, typename PositionSpace, unsigned Dim>
 class ParticleBaseTest<Parameters<T, IDSpace, PositionSpace, Rank<Dim>>> : public ::testing::Test {
 public:
     using value_type     = T;
+    using vector_type    = ippl::Vector<T, Dim>;
     using attribute_type = ippl::ParticleAttrib<T, PositionSpace>;
     using bool_type      = typename ippl::detail::ViewType<bool, 1, PositionSpace>::view_type;
 
@@ -88,6 +92,101 @@ TYPED_TEST(ParticleBaseTest, CreateAndDestroy) {
     }
 }
 
+TYPED_TEST(ParticleBaseTest, CreateLocal) {
+    using index_type = typename TestFixture::bunch_type::index_type;
+
+    auto& pbase = this->pbase;
+
+    const index_type rank   = ippl::Comm->rank();
+    const index_type nRanks = ippl::Comm->size();
+
+    // Only every other rank creates particles, without synchronizing
+    const size_t nInjected = (rank % 2 == 0) ? 10 : 0;
+    pbase->createLocal(nInjected);
+    EXPECT_EQ(pbase->isTotalNumStale(), nInjected > 0);
+
+    // Batched IDs in rank order
+    const size_t nBatch = rank + 1;
+    index_type first    = pbase->allocateIDs(nBatch);
+    pbase->createLocal(nBatch, first);
+
+    pbase->updateTotalNum();
+    EXPECT_FALSE(pbase->isTotalNumStale());
+
+    size_t total = 0;
+    for (index_type r = 0; r < nRanks; ++r) {
+        total += (r % 2 == 0 ? 10 : 0) + r + 1;
+    }
+    EXPECT_EQ(pbase->getTotalNum(), total);
+
+    // The blocks start behind the largest interleaved ID handed out by any rank
+    const index_type lastEven = (nRanks - 1) - (nRanks - 1) % 2;
+    const index_type base     = lastEven + 10 * nRanks;
+    EXPECT_EQ(first, base + rank * (rank + 1) / 2);
+
+    pbase->createLocal(5);
+    ASSERT_EQ(pbase->getLocalNum(), nInjected + nBatch + 5);
+
+    auto ids = pbase->ID.getHostMirror();
+    Kokkos::deep_copy(ids, pbase->ID.getView());
+    for (size_t i = 0; i < nInjected; ++i) {
+        EXPECT_EQ(ids(i), rank + nRanks * index_type(i));
+    }
+    for (size_t i = 0; i < nBatch; ++i) {
+        EXPECT_EQ(ids(nInjected + i), first + index_type(i));
+    }
+    // Later interleaved IDs do not collide with the reserved blocks
+    const index_type end = base + nRanks * (nRanks + 1) / 2;
+    for (size_t i = nInjected + nBatch; i < nInjected + nBatch + 5; ++i) {
+        EXPECT_GE(ids(i), end);
+        EXPECT_EQ(ids(i) % nRanks, rank);
+    }
+}
+
+TYPED_TEST(ParticleBaseTest, CapacityPolicy) {
+    using index_type = typename TestFixture::bunch_type::index_type;
+
+    auto& pbase = this->pbase;
+    pbase->setCapacityPolicy(2.0, 0.25);
+
+    pbase->create(100);
+    EXPECT_EQ(pbase->getCapacity(), size_t(200));
+
+    // Growing preserves the existing particles
+    pbase->create(150);
+    EXPECT_EQ(pbase->getCapacity(), size_t(500));
+
+    auto ids = pbase->ID.getHostMirror();
+    Kokkos::deep_copy(ids, pbase->ID.getView());
+
+    // Destroy all but every fifth particle
+    std::vector<index_type> expected;
+    typename TestFixture::bool_type invalid("invalid", 250);
+    auto invalid_host = Kokkos::create_mirror_view(invalid);
+    for (size_t i = 0; i < 250; ++i) {
+        invalid_host(i) = i % 5 != 0;
+        if (i % 5 == 0) {
+            expected.push_back(ids(i));
+        }
+    }
+    Kokkos::deep_copy(invalid, invalid_host);
+    pbase->destroy(invalid, 200);
+
+    // 50 < 0.25 * 500, so the storage shrinks to 50 times the growth factor
+    ASSERT_EQ(pbase->getLocalNum(), size_t(50));
+    EXPECT_EQ(pbase->getCapacity(), size_t(100));
+
+    pbase->shrinkToFit();
+    EXPECT_EQ(pbase->getCapacity(), size_t(50));
+
+    ids = pbase->ID.getHostMirror();
+    Kokkos::deep_copy(ids, pbase->ID.getView());
+    std::vector<index_type> remaining(ids.data(), ids.data() + 50);
+    std::sort(remaining.begin(), remaining.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(remaining, expected);
+}
+
 TYPED_TEST(ParticleBaseTest, AddAttribute) {
     using attrib_type = typename TestFixture::attribute_type;
 
@@ -102,6 +201,286 @@ TYPED_TEST(ParticleBaseTest, AddAttribute) {
     EXPECT_EQ(size_t(3), nAttributes);
 }
 
+TYPED_TEST(ParticleBaseTest, Sort) {
+    using memory_space  = typename TestFixture::bool_type::memory_space;
+    using key_view_type = typename ippl::detail::ViewType<int, 1, memory_space>::view_type;
+
+    auto& pbase = this->pbase;
+
+    const int nParticles = 1000;
+    const int nKeys      = 10;
+    pbase->create(nParticles);
+
+    auto ids = pbase->ID.getHostMirror();
+    Kokkos::deep_copy(ids, pbase->ID.getView());
+
+    // Scramble the keys with respect to the storage order
+    key_view_type keys("keys", nParticles);
+    auto keys_host = Kokkos::create_mirror_view(keys);
+    for (int i = 0; i < nParticles; ++i) {
+        keys_host(i) = (7 * ids(i)) % nKeys;
+    }
+    Kokkos::deep_copy(keys, keys_host);
+
+    pbase->sort(keys, nKeys);
+
+    Kokkos::deep_copy(ids, pbase->ID.getView());
+    std::vector<bool> seen(nParticles, false);
+    int prevKey = 0;
+    for (int i = 0; i < nParticles; ++i) {
+        // Recover the original index from the (rank-interleaved) ID
+        int index = (ids(i) - ippl::Comm->rank()) / ippl::Comm->size();
+        ASSERT_LT(index, nParticles);
+        EXPECT_FALSE(seen[index]);
+        seen[index] = true;
+
+        int key = (7 * ids(i)) % nKeys;
+        EXPECT_LE(prevKey, key);
+        prevKey = key;
+    }
+}
+
+TYPED_TEST(ParticleBaseTest, StructOfArrays) {
+    using T             = typename TestFixture::value_type;
+    using vector_type   = typename TestFixture::vector_type;
+    using memory_space  = typename TestFixture::bool_type::memory_space;
+    using key_view_type = typename ippl::detail::ViewType<int, 1, memory_space>::view_type;
+    constexpr unsigned Dim = vector_type::dim;
+
+    auto& pbase = this->pbase;
+
+    ippl::ParticleAttrib<vector_type, ippl::SoA, memory_space> Q;
+    ippl::ParticleAttrib<vector_type, memory_space> V;
+    pbase->addAttribute(Q);
+    pbase->addAttribute(V);
+
+    const int nParticles = 1000;
+    pbase->create(nParticles);
+
+    auto ids = pbase->ID.getHostMirror();
+    Kokkos::deep_copy(ids, pbase->ID.getView());
+
+    auto V_host = V.getHostMirror();
+    for (int i = 0; i < nParticles; ++i) {
+        for (unsigned d = 0; d < Dim; ++d) {
+            V_host(i)[d] = ids(i) + d;
+        }
+    }
+    Kokkos::deep_copy(V.getView(), V_host);
+
+    // Expressions mixing both storage policies
+    Q = T(2) * V;
+    V = V + Q;
+
+    // Reverse the storage order
+    key_view_type keys("keys", nParticles);
+    auto keys_host = Kokkos::create_mirror_view(keys);
+    for (int i = 0; i < nParticles; ++i) {
+        keys_host(i) = nParticles - 1 - i;
+    }
+    Kokkos::deep_copy(keys, keys_host);
+    pbase->sort(keys, nParticles);
+
+    Kokkos::deep_copy(ids, pbase->ID.getView());
+    Kokkos::deep_copy(V_host, V.getView());
+    auto Q_host = Q.getHostMirror();
+    Kokkos::deep_copy(Q_host, Q.getView());
+    for (int i = 0; i < nParticles; ++i) {
+        for (unsigned d = 0; d < Dim; ++d) {
+            const T expected = ids(i) + d;
+            assertEqual<T>(Q_host(i, d), 2 * expected);
+            assertEqual<T>(V_host(i)[d], 3 * expected);
+        }
+    }
+}
+
+TYPED_TEST(ParticleBaseTest, AttributeList) {
+    using T            = typename TestFixture::value_type;
+    using vector_type  = typename TestFixture::vector_type;
+    using memory_space = typename TestFixture::bool_type::memory_space;
+    using hash_type    = ippl::detail::hash_type<memory_space>;
+    constexpr unsigned Dim = vector_type::dim;
+
+    using scalar_type = ippl::ParticleAttrib<T, memory_space>;
+    using soa_type    = ippl::ParticleAttrib<vector_type, ippl::SoA, memory_space>;
+    using aos_type    = ippl::ParticleAttrib<vector_type, memory_space>;
+
+    auto& pbase = this->pbase;
+
+    scalar_type Q;
+    soa_type V;
+    aos_type E;
+    ippl::ParticleAttribList<scalar_type, soa_type, aos_type> list(Q, V, E);
+    static_assert(decltype(list)::elementSize == (2 * Dim + 1) * sizeof(T));
+
+    pbase->addAttribute(list);
+    EXPECT_EQ(pbase->getAttributeNum(), size_t(3));
+
+    const int nParticles = 100;
+    pbase->create(nParticles);
+    EXPECT_GE(Q.size(), size_t(nParticles));
+    EXPECT_GE(V.size(), size_t(nParticles));
+    EXPECT_GE(E.size(), size_t(nParticles));
+
+    auto ids = pbase->ID.getHostMirror();
+    Kokkos::deep_copy(ids, pbase->ID.getView());
+
+    auto Q_host = Q.getHostMirror();
+    auto V_host = V.getHostMirror();
+    auto E_host = E.getHostMirror();
+    for (int i = 0; i < nParticles; ++i) {
+        Q_host(i) = ids(i);
+        for (unsigned d = 0; d < Dim; ++d) {
+            V_host(i, d) = ids(i) + d;
+            E_host(i)[d] = ids(i) - T(d);
+        }
+    }
+    Kokkos::deep_copy(Q.getView(), Q_host);
+    Kokkos::deep_copy(V.getView(), V_host);
+    Kokkos::deep_copy(E.getView(), E_host);
+
+    auto check = [&](int n) {
+        Kokkos::deep_copy(ids, pbase->ID.getView());
+        Kokkos::deep_copy(Q_host, Q.getView());
+        Kokkos::deep_copy(V_host, V.getView());
+        Kokkos::deep_copy(E_host, E.getView());
+        for (int i = 0; i < n; ++i) {
+            const T id = ids(i);
+            assertEqual<T>(Q_host(i), id);
+            for (unsigned d = 0; d < Dim; ++d) {
+                assertEqual<T>(V_host(i, d), id + d);
+                assertEqual<T>(E_host(i)[d], id - T(d));
+            }
+        }
+    };
+
+    // Destroy the particles with even indices
+    typename TestFixture::bool_type invalid("invalid", nParticles);
+    auto invalid_host = Kokkos::create_mirror_view(invalid);
+    for (int i = 0; i < nParticles; ++i) {
+        invalid_host(i) = i % 2 == 0;
+    }
+    Kokkos::deep_copy(invalid, invalid_host);
+    pbase->destroy(invalid, nParticles / 2);
+
+    const int nLocal = nParticles / 2;
+    ASSERT_EQ(pbase->getLocalNum(), size_t(nLocal));
+    check(nLocal);
+
+    // Pack some particles in reverse order and unpack them behind the local ones
+    const int nSends = 10;
+    hash_type hash("hash", nSends);
+    auto hash_host = Kokkos::create_mirror_view(hash);
+    for (int i = 0; i < nSends; ++i) {
+        hash_host(i) = nLocal - 1 - 3 * i;
+    }
+    Kokkos::deep_copy(hash, hash_host);
+
+    ippl::detail::Archive<memory_space> ar(list.packedSize(nSends));
+    list.pack(ar, hash);
+    EXPECT_EQ(ar.getSize(), list.packedSize(nSends));
+
+    list.unpack(ar, nSends);
+    Kokkos::deep_copy(Q_host, Q.getView());
+    Kokkos::deep_copy(V_host, V.getView());
+    Kokkos::deep_copy(E_host, E.getView());
+    for (int i = 0; i < nSends; ++i) {
+        const int src = hash_host(i);
+        assertEqual<T>(Q_host(nLocal + i), Q_host(src));
+        for (unsigned d = 0; d < Dim; ++d) {
+            assertEqual<T>(V_host(nLocal + i, d), V_host(src, d));
+            assertEqual<T>(E_host(nLocal + i)[d], E_host(src)[d]);
+        }
+    }
+}
+
+TYPED_TEST(ParticleBaseTest, FusedAssignment) {
+    using T            = typename TestFixture::value_type;
+    using vector_type  = typename TestFixture::vector_type;
+    using memory_space = typename TestFixture::bool_type::memory_space;
+    constexpr unsigned Dim = vector_type::dim;
+
+    using scalar_type = ippl::ParticleAttrib<T, memory_space>;
+    using soa_type    = ippl::ParticleAttrib<vector_type, ippl::SoA, memory_space>;
+    using aos_type    = ippl::ParticleAttrib<vector_type, memory_space>;
+
+    auto& pbase = this->pbase;
+
+    scalar_type q;
+    soa_type P;
+    aos_type X, E;
+    pbase->addAttribute(q);
+    pbase->addAttribute(P);
+    pbase->addAttribute(X);
+    pbase->addAttribute(E);
+
+    const int nParticles = 100;
+    pbase->create(nParticles);
+
+    auto ids = pbase->ID.getHostMirror();
+    Kokkos::deep_copy(ids, pbase->ID.getView());
+
+    auto E_host = E.getHostMirror();
+    for (int i = 0; i < nParticles; ++i) {
+        for (unsigned d = 0; d < Dim; ++d) {
+            E_host(i)[d] = ids(i) + d;
+        }
+    }
+    Kokkos::deep_copy(E.getView(), E_host);
+    q = T(2);
+    P = T(1);
+    X = T(0);
+
+    // The position update sees the updated momentum
+    const T dt = 0.5;
+    ippl::fusedAssign(ippl::assignment(P, P + dt * q * E), ippl::assignment(X, X + dt * P));
+
+    auto P_host = P.getHostMirror();
+    auto X_host = X.getHostMirror();
+    Kokkos::deep_copy(P_host, P.getView());
+    Kokkos::deep_copy(X_host, X.getView());
+    for (int i = 0; i < nParticles; ++i) {
+        for (unsigned d = 0; d < Dim; ++d) {
+            const T expected = 1 + dt * 2 * (ids(i) + d);
+            assertEqual<T>(P_host(i, d), expected);
+            assertEqual<T>(X_host(i)[d], dt * expected);
+        }
+    }
+}
+
+TYPED_TEST(ParticleBaseTest, BatchedReduction) {
+    using T            = typename TestFixture::value_type;
+    using memory_space = typename TestFixture::bool_type::memory_space;
+    using exec_space   = typename memory_space::execution_space;
+
+    auto& pbase = this->pbase;
+
+    typename TestFixture::attribute_type q;
+    pbase->addAttribute(q);
+
+    const int nParticles = 100;
+    pbase->create(nParticles);
+
+    // q = 1, ..., nParticles on every rank
+    auto q_host = q.getHostMirror();
+    for (int i = 0; i < nParticles; ++i) {
+        q_host(i) = i + 1;
+    }
+    Kokkos::deep_copy(q.getView(), q_host);
+
+    auto [sum, squares, max, min] =
+        ippl::reduceParticles<exec_space>(pbase->getLocalNum(), ippl::sumOf(q),
+                                          ippl::sumOf(q * q), ippl::maxOf(q), ippl::minOf(q));
+
+    const T nRanks = ippl::Comm->size();
+    const T n      = nParticles;
+    assertEqual<T>(sum, nRanks * n * (n + 1) / 2);
+    assertEqual<T>(squares, nRanks * n * (n + 1) * (2 * n + 1) / 6);
+    assertEqual<T>(max, n);
+    assertEqual<T>(min, T(1));
+    assertEqual<T>(sum, q.sum());
+}
+
 TYPED_TEST(InitializationTest, Initialize1) {
     typename TestFixture::playout_type pl;
     typename TestFixture::bunch_type bunch(pl);
@@ -16,10 +16,13 @@ class ParticleSendRecv;
 template <typename T, typename ExecSpace, unsigned Dim>
 class ParticleSendRecv<Parameters<T, ExecSpace, Rank<Dim>>> : public ::testing::Test {
 public:
-    using flayout_type   = ippl::FieldLayout<Dim>;
-    using mesh_type      = ippl::UniformCartesian<T, Dim>;
-    using playout_type   = ippl::ParticleSpatialLayout<T, Dim, mesh_type, ExecSpace>;
-    using RegionLayout_t = typename playout_type::RegionLayout_t;
+    constexpr static unsigned dim = Dim;
+    using value_type              = T;
+    using execution_space         = ExecSpace;
+    using flayout_type            = ippl::FieldLayout<Dim>;
+    using mesh_type               = ippl::UniformCartesian<T, Dim>;
+    using playout_type            = ippl::ParticleSpatialLayout<T, Dim, mesh_type, ExecSpace>;
+    using RegionLayout_t          = typename playout_type::RegionLayout_t;
 
     using rank_type = ippl::ParticleAttrib<int, ExecSpace>;
 
@@ -84,12 +87,15 @@ public:
         }
 
         bunch->create(nParticles / nRanks);
+        randomizePositions(*bunch, ippl::Comm->rank());
+    }
 
-        std::mt19937_64 eng(ippl::Comm->rank());
+    void randomizePositions(bunch_type& b, unsigned seed) {
+        std::mt19937_64 eng(seed);
         std::uniform_real_distribution<T> unif(0, 1);
 
-        auto R_host = bunch->R.getHostMirror();
-        for (size_t i = 0; i < bunch->getLocalNum(); ++i) {
+        auto R_host = b.R.getHostMirror();
+        for (size_t i = 0; i < b.getLocalNum(); ++i) {
             ippl::Vector<T, Dim> r;
             for (unsigned d = 0; d < Dim; d++) {
                 r[d] = unif(eng) * domain[d];
@@ -97,21 +103,22 @@ public:
             R_host(i) = r;
         }
 
-        Kokkos::deep_copy(bunch->R.getView(), R_host);
-        bunch->Q = 1.0;
+        Kokkos::deep_copy(b.R.getView(), R_host);
+        b.Q = 1.0;
 
-        computeExpectedRanks();
+        computeExpectedRanks(b);
     }
 
-    void computeExpectedRanks() {
+    template <typename Bunch>
+    void computeExpectedRanks(Bunch& b) {
         using region_view  = typename RegionLayout_t::view_type;
         using size_type    = typename RegionLayout_t::view_type::size_type;
         using mdrange_type = Kokkos::MDRangePolicy<Kokkos::Rank<2>, ExecSpace>;
 
         RegionLayout_t RLayout           = playout.getRegionLayout();
-        auto& positions                  = bunch->R.getView();
+        auto& positions                  = b.R.getView();
         region_view Regions              = RLayout.getdLocalRegions();
-        typename rank_type::view_type ER = bunch->expectedRank.getView();
+        typename rank_type::view_type ER = b.expectedRank.getView();
 
         Kokkos::parallel_for(
             "Expected Rank", mdrange_type({0, 0}, {ER.extent(0), Regions.extent(0)}),
@@ -146,6 +153,9 @@ TYPED_TEST(ParticleSendRecv, SendAndRecieve) {
     auto& bunch           = this->bunch;
 
     bunch->update();
+    // Redistribution does not change the total
+    EXPECT_FALSE(bunch->isTotalNumStale());
+
     typename TestFixture::rank_type::view_type::host_mirror_type ER_host =
         bunch->expectedRank.getHostMirror();
 
@@ -162,11 +172,104 @@ TYPED_TEST(ParticleSendRecv, SendAndRecieve) {
 
     ippl::Comm->reduce(local_particles, Total_particles, 1, std::plus<unsigned int>());
 
+    EXPECT_EQ(bunch->getTotalNum(), size_t(nParticles));
+    EXPECT_FALSE(bunch->isTotalNumStale());
+
     if (ippl::Comm->rank() == 0) {
         ASSERT_EQ(nParticles, Total_particles);
     }
 }
 
+TYPED_TEST(ParticleSendRecv, SpeciesGroup) {
+    const unsigned nRanks = ippl::Comm->size();
+    auto& electrons       = *this->bunch;
+
+    typename TestFixture::bunch_type ions(this->playout);
+    ions.create(2 * this->nParticles / nRanks);
+    this->randomizePositions(ions, nRanks + ippl::Comm->rank());
+
+    ippl::ParticleSpeciesGroup species(electrons, ions);
+    species.update();
+
+    for (auto* b : {&electrons, &ions}) {
+        auto ER_host = b->expectedRank.getHostMirror();
+        Kokkos::deep_copy(ER_host, b->expectedRank.getView());
+        for (size_t i = 0; i < b->getLocalNum(); ++i) {
+            ASSERT_EQ(ER_host(i), ippl::Comm->rank());
+        }
+    }
+
+    ASSERT_EQ(electrons.getTotalNum(), this->nParticles / nRanks * nRanks);
+    ASSERT_EQ(ions.getTotalNum(), 2 * this->nParticles / nRanks * nRanks);
+}
+
+TYPED_TEST(ParticleSendRecv, SharedMemory) {
+    using T               = typename TestFixture::value_type;
+    using execution_space = typename TestFixture::execution_space;
+    using playout_type    = typename TestFixture::playout_type;
+
+    // Attributes in two memory spaces, which travel in one message per space
+    struct MixedBunch : public ippl::ParticleBase<playout_type> {
+        explicit MixedBunch(playout_type& playout)
+            : ippl::ParticleBase<playout_type>(playout) {
+            this->addAttribute(expectedRank);
+            this->addAttribute(Q);
+            this->addAttribute(hostQ);
+        }
+
+        typename TestFixture::rank_type expectedRank;
+        ippl::ParticleAttrib<T, execution_space> Q;
+        ippl::ParticleAttrib<T, Kokkos::HostSpace> hostQ;
+    };
+
+    const bool previous                         = ippl::mpi::Communicator::enableSharedMemory;
+    ippl::mpi::Communicator::enableSharedMemory = true;
+
+    const int rank          = ippl::Comm->rank();
+    const size_t nLocal     = this->nParticles / ippl::Comm->size();
+    const size_t nParticles = nLocal * ippl::Comm->size();
+
+    MixedBunch bunch(this->playout);
+    bunch.create(nLocal);
+
+    std::mt19937_64 eng(rank);
+    std::uniform_real_distribution<T> unif(0, 1);
+    auto R_host = bunch.R.getHostMirror();
+    auto Q_host = bunch.Q.getHostMirror();
+    auto hostQ  = bunch.hostQ.getView();
+    for (size_t i = 0; i < nLocal; ++i) {
+        for (unsigned d = 0; d < TestFixture::dim; d++) {
+            R_host(i)[d] = unif(eng) * this->domain[d];
+        }
+        Q_host(i) = rank * nLocal + i + 1;
+        hostQ(i)  = Q_host(i);
+    }
+    Kokkos::deep_copy(bunch.R.getView(), R_host);
+    Kokkos::deep_copy(bunch.Q.getView(), Q_host);
+    this->computeExpectedRanks(bunch);
+
+    bunch.update();
+
+    // Every particle arrives at its rank with the attributes of both spaces intact
+    auto ER_host = bunch.expectedRank.getHostMirror();
+    Q_host       = bunch.Q.getHostMirror();
+    Kokkos::deep_copy(ER_host, bunch.expectedRank.getView());
+    Kokkos::deep_copy(Q_host, bunch.Q.getView());
+    hostQ      = bunch.hostQ.getView();
+    double sum = 0;
+    for (size_t i = 0; i < bunch.getLocalNum(); ++i) {
+        ASSERT_EQ(ER_host(i), rank);
+        ASSERT_EQ(Q_host(i), hostQ(i));
+        sum += Q_host(i);
+    }
+
+    ippl::Comm->allreduce(sum, 1, std::plus<double>());
+    EXPECT_EQ(bunch.getTotalNum(), nParticles);
+    EXPECT_DOUBLE_EQ(sum, nParticles * (nParticles + 1) / 2.);
+
+    ippl::mpi::Communicator::enableSharedMemory = previous;
+}
+
 int main(int argc, char* argv[]) {
     int success = 1;
     ippl::initialize(argc, argv);